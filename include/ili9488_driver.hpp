@@ -1,6 +1,22 @@
 // ili9488_driver.hpp - simpele, stabiele driver voor ILI9488 + LVGL
 #pragma once
 #include <Arduino.h>
+#include <string.h>
+#include "lcd_bus.hpp"
+#include "lcd_i80_dma.hpp"
+#if !defined(ESP_PLATFORM)
+#include "lcd_bus_fake.hpp"
+#endif
+
+// ==== TRANSPORT (compile-time keuze) ====
+// Standaard: CPU bit-bang via GPIO-registers.
+// -DILI9488_TRANSPORT_I80 : LCD_CAM i80-peripheral + DMA (ESP32-S3), zelfde pinnen.
+#ifndef ILI9488_I80_PCLK_HZ
+#define ILI9488_I80_PCLK_HZ     20000000   // WR-klok van de i80-bus
+#endif
+#ifndef ILI9488_I80_CHUNK_BYTES
+#define ILI9488_I80_CHUNK_BYTES (2 * 4092) // per staging-buffer (er zijn er 2)
+#endif
 
 // ==== PIN DEFINITIES (pas aan als jouw PCB anders is) ====
 #define LCD_D0   10
@@ -26,36 +42,52 @@ static const int lcd_data_pins[8] = {
   LCD_D4, LCD_D5, LCD_D6, LCD_D7
 };
 
+// Databus moet aaneengesloten zijn: dan is een byte schrijven één shift + register-store
+static_assert(LCD_D1 == LCD_D0 + 1 && LCD_D2 == LCD_D0 + 2 && LCD_D3 == LCD_D0 + 3 &&
+              LCD_D4 == LCD_D0 + 4 && LCD_D5 == LCD_D0 + 5 && LCD_D6 == LCD_D0 + 6 &&
+              LCD_D7 == LCD_D0 + 7, "LCD_D0..LCD_D7 moeten opeenvolgende GPIO's zijn");
+
+struct Ili9488Pins {
+  static constexpr int D0 = LCD_D0;
+  static constexpr int WR = LCD_WR;
+  static constexpr int RS = LCD_RS;
+  static constexpr int CS = LCD_CS;
+};
+
+#if defined(ESP_PLATFORM)
+using LcdBus = lcdbus::ParallelBus8<Ili9488Pins, lcdbus::Esp32GpioRegs>;
+#else
+// Host build: schrijft naar een nep-registerbestand dat de busbytes opvangt
+using LcdBusRegs = lcdbus::FakeGpioRegs<Ili9488Pins>;
+using LcdBus     = lcdbus::ParallelBus8<Ili9488Pins, LcdBusRegs>;
+#endif
+
+// Zet D0..D7 en geeft een WR-puls (3 register-stores i.p.v. 10 digitalWrite's)
 inline void lcd_busWrite(uint8_t v)
 {
-  for (int i = 0; i < 8; i++) {
-    digitalWrite(lcd_data_pins[i], (v >> i) & 0x01);
-  }
+  LcdBus::write(v);
 }
 
+// Alleen WR pulsen: de vorige byte wordt nog een keer gelatcht
 inline void lcd_pulseWR()
 {
-  digitalWrite(LCD_WR, LOW);
-  __asm__ __volatile__("nop\nnop\nnop\nnop\nnop\n");
-  digitalWrite(LCD_WR, HIGH);
+  LcdBus::strobe();
 }
 
 inline void lcd_writeCommand(uint8_t cmd)
 {
-  digitalWrite(LCD_RS, LOW);
-  digitalWrite(LCD_CS, LOW);
+  LcdBus::rs_command();
+  LcdBus::cs_low();
   lcd_busWrite(cmd);
-  lcd_pulseWR();
-  digitalWrite(LCD_CS, HIGH);
+  LcdBus::cs_high();
 }
 
 inline void lcd_writeData(uint8_t data)
 {
-  digitalWrite(LCD_RS, HIGH);
-  digitalWrite(LCD_CS, LOW);
+  LcdBus::rs_data();
+  LcdBus::cs_low();
   lcd_busWrite(data);
-  lcd_pulseWR();
-  digitalWrite(LCD_CS, HIGH);
+  LcdBus::cs_high();
 }
 
 inline void lcd_writeColor(uint16_t c)
@@ -65,6 +97,432 @@ inline void lcd_writeColor(uint16_t c)
   lcd_writeData(c & 0xFF);
 }
 
+// ---- Transacties: CS blijft laag over een hele reeks commando's en data ----
+
+inline void lcd_txBegin() { LcdBus::rs_data(); LcdBus::cs_low(); }
+inline void lcd_txEnd()   { LcdBus::cs_high(); }
+
+// Binnen een transactie: RS alleen laag tijdens de commandobyte, daarna weer data
+inline void lcd_txCommand(uint8_t cmd)
+{
+  LcdBus::rs_command();
+  lcd_busWrite(cmd);
+  LcdBus::rs_data();
+}
+
+inline void lcd_txData(uint8_t data)
+{
+  lcd_busWrite(data);
+}
+
+// Adresseringscommando's voor het begin van een RAMWR-burst. Niet alles hoeft
+// altijd: zie Ili9488WindowTracker, die CASET/PASET weglaat als het window al klopt.
+struct Ili9488WindowCmd {
+  bool     caset;
+  uint16_t x1, x2;
+  bool     paset;
+  uint16_t y1, y2;
+  uint8_t  ramwr;   // 0x2C (pointer terug naar window-start) of 0x3C (doorgaan)
+
+  // Volledig window voor het gebied (x, y, w, h)
+  static Ili9488WindowCmd full(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+  {
+    return { true, x, uint16_t(x + w - 1), true, y, uint16_t(y + h - 1), 0x2C };
+  }
+};
+
+// CASET / PASET / RAMWR binnen een open transactie
+inline void lcd_txWindow(const Ili9488WindowCmd& c)
+{
+  if (c.caset) {
+    // Column address set
+    lcd_txCommand(0x2A);
+    lcd_txData(c.x1 >> 8);
+    lcd_txData(c.x1 & 0xFF);
+    lcd_txData(c.x2 >> 8);
+    lcd_txData(c.x2 & 0xFF);
+  }
+
+  if (c.paset) {
+    // Page address set
+    lcd_txCommand(0x2B);
+    lcd_txData(c.y1 >> 8);
+    lcd_txData(c.y1 & 0xFF);
+    lcd_txData(c.y2 >> 8);
+    lcd_txData(c.y2 & 0xFF);
+  }
+
+  // RAMWR of Memory Write Continue
+  lcd_txCommand(c.ramwr);
+}
+
+inline void lcd_txWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+  lcd_txWindow(Ili9488WindowCmd::full(x, y, w, h));
+}
+
+// Houdt bij welk window en welke schrijfpointer de controller nu heeft.
+// Als het volgende gebied precies verder gaat waar het vorige ophield (zoals de
+// 10-lijns stripes van LVGL PARTIAL), is alleen RAMWRC (1 byte) nodig i.p.v. 11.
+// Daarom loopt PASET altijd door tot de onderkant van het scherm.
+struct Ili9488WindowTracker {
+  bool     valid = false;
+  uint16_t x1 = 0, x2 = 0, y1 = 0, y2 = 0;   // window in de controller
+  uint16_t col = 0, page = 0;                // schrijfpointer
+  uint16_t rows = ILI9488_WIDTH;             // logische hoogte (rotatie 1 = landscape)
+
+  void invalidate() { valid = false; }
+
+  Ili9488WindowCmd plan(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+  {
+    const uint16_t ax2 = x + w - 1;
+    const uint16_t ay2 = y + h - 1;
+    const bool cols_ok = valid && x1 == x && x2 == ax2;
+
+    Ili9488WindowCmd c = { false, x, ax2, false, y, ay2, 0x3C };
+
+    if (!(cols_ok && col == x && page == y && ay2 <= y2)) {
+      c.caset = !cols_ok;
+      c.paset = true;
+      c.y2    = (ay2 > rows - 1) ? ay2 : uint16_t(rows - 1);
+      c.ramwr = 0x2C;
+
+      x1 = x;  x2 = ax2;
+      y1 = c.y1;  y2 = c.y2;
+      col = x;  page = y;
+      valid = true;
+    }
+    return c;
+  }
+
+  // Schrijfpointer opschuiven zoals de controller dat doet (kolom eerst, wrap in window)
+  void advance(uint32_t pixels)
+  {
+    if (!valid) return;
+    const uint32_t w   = uint32_t(x2 - x1) + 1;
+    const uint32_t h   = uint32_t(y2 - y1) + 1;
+    const uint32_t off = (uint32_t(col - x1) + pixels);
+    const uint32_t row = (uint32_t(page - y1) + off / w) % h;
+    col  = uint16_t(x1 + off % w);
+    page = uint16_t(y1 + row);
+  }
+};
+
+inline Ili9488WindowTracker& ili9488_window()
+{
+  static Ili9488WindowTracker t;
+  return t;
+}
+
+// ==== PIXELFORMAAT (compile-time keuze) ====
+// Standaard rendert LVGL RGB565 little endian en toont het paneel (met INVOFF)
+// alles geïnverteerd, dus elke pixel wordt omgedraaid + geïnverteerd.
+// -DILI9488_NATIVE_PIXELS : LVGL rendert RGB565_SWAPPED (big endian) en het paneel
+// krijgt INVON, dan staat het buffer al precies zoals het paneel het wil en is de
+// flush een kale memory -> bus stream.
+
+struct Rgb565Inverted {
+  static constexpr bool    kRaw   = false;
+  static constexpr uint8_t kInvon = 0x20;   // INVOFF
+
+  // Twee bufferbytes -> 16-bit waarde zoals het paneel hem wil
+  static inline uint16_t panel(uint8_t b0, uint8_t b1) {
+    uint16_t c = (static_cast<uint16_t>(b1) << 8) | b0;
+
+    // compenseer paneel-inversie
+    return static_cast<uint16_t>(~c);
+  }
+
+  static inline uint16_t fill(uint16_t color) { return static_cast<uint16_t>(~color); }
+  // Kleur zoals write_color hem verwacht, uit twee bufferbytes
+  static inline uint16_t lvgl(uint8_t b0, uint8_t b1) { return (static_cast<uint16_t>(b1) << 8) | b0; }
+};
+
+struct Rgb565Native {
+  static constexpr bool    kRaw   = true;
+  static constexpr uint8_t kInvon = 0x21;   // INVON: paneel compenseert zelf
+
+  static inline uint16_t panel(uint8_t b0, uint8_t b1) {
+    return (static_cast<uint16_t>(b0) << 8) | b1;
+  }
+
+  static inline uint16_t fill(uint16_t color) { return color; }
+  static inline uint16_t lvgl(uint8_t b0, uint8_t b1) { return (static_cast<uint16_t>(b0) << 8) | b1; }
+};
+
+#if defined(ILI9488_NATIVE_PIXELS)
+using Ili9488PixelFormat = Rgb565Native;
+#else
+using Ili9488PixelFormat = Rgb565Inverted;
+#endif
+
+// ==== TRANSPORTS ====
+// Beide hebben dezelfde static interface:
+//   init()                         pinnen / peripheral klaarzetten
+//   command(cmd, params, n)        losse commando-transactie (init, rotatie, ...)
+//   begin_ramwr(cmd)               CASET/PASET waar nodig + RAMWR/RAMWRC
+//   begin_ramwr(x, y, w, h)        idem met een volledig window
+//   pixels(px_map, count)          LVGL-pixels (RGB565 LE) streamen
+//   color(color, count)            één kleur count keer
+//   end_ramwr()                    burst afsluiten (wacht tot alles op de bus staat)
+
+// ---- Transport 1: CPU bit-bang via GPIO set/clear registers ----
+template <class Fmt = Ili9488PixelFormat>
+struct BitBangTransportT {
+  // Effen vlak met gelijke hoge en lage byte: alleen WR pulsen (zie color())
+  static constexpr bool kWrOnlyFill = true;
+
+  static bool init()
+  {
+    // Datapinnen + control-pinnen als output
+    for (int i = 0; i < 8; i++) {
+      pinMode(lcd_data_pins[i], OUTPUT);
+      digitalWrite(lcd_data_pins[i], LOW);
+    }
+    pinMode(LCD_CS, OUTPUT);
+    pinMode(LCD_RS, OUTPUT);
+    pinMode(LCD_WR, OUTPUT);
+    LcdBus::idle();
+    return true;
+  }
+
+  // Niks vast te houden: init() zet de pinnen opnieuw
+  static void deinit() {}
+
+  static void command(uint8_t cmd, const uint8_t *params = nullptr, size_t n = 0)
+  {
+    lcd_txBegin();
+    lcd_txCommand(cmd);
+    for (size_t i = 0; i < n; i++) lcd_txData(params[i]);
+    lcd_txEnd();
+  }
+
+  static void begin_ramwr(const Ili9488WindowCmd& c)
+  {
+    lcd_txBegin();
+    lcd_txWindow(c);
+  }
+
+  static void begin_ramwr(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+  {
+    begin_ramwr(Ili9488WindowCmd::full(x, y, w, h));
+  }
+
+  static void pixels(const uint8_t *px_map, uint32_t count)
+  {
+    if constexpr (Fmt::kRaw) {
+      // buffer staat al in paneelvolgorde: byte voor byte de bus op
+      const uint32_t bytes = 2 * count;
+      for (uint32_t i = 0; i < bytes; i++) lcd_busWrite(px_map[i]);
+    } else {
+      for (uint32_t i = 0; i < count; i++) {
+        uint16_t c = Fmt::panel(px_map[2 * i + 0], px_map[2 * i + 1]);
+        lcd_busWrite(c >> 8);
+        lcd_busWrite(c & 0xFF);
+      }
+    }
+  }
+
+  static void color(uint16_t color, uint32_t count)
+  {
+    const uint16_t c = Fmt::fill(color);
+    if (count == 0) return;
+
+    if ((c >> 8) == (c & 0xFF)) {
+      // Hoge en lage byte gelijk (zwart, wit, ...): byte 1x op de bus zetten,
+      // daarna alleen WR togglen. 2 stores per byte i.p.v. 3.
+      lcd_busWrite(c & 0xFF);
+      for (uint32_t i = 1; i < 2 * count; i++) LcdBus::strobe();
+      return;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+      lcd_busWrite(c >> 8);
+      lcd_busWrite(c & 0xFF);
+    }
+  }
+
+  static void end_ramwr()
+  {
+    lcd_txEnd();
+  }
+};
+
+using BitBangTransport = BitBangTransportT<>;
+
+// ---- Transport 2: LCD_CAM i80 + DMA ----
+// Pixels worden per chunk omgezet naar paneelbytes in één van twee DMA-buffers;
+// terwijl de DMA chunk N verstuurt vult de CPU chunk N+1. Eerste chunk gaat met
+// RAMWR (0x2C), de rest met Memory Write Continue (0x3C).
+// In native-pixelmodus is er niks om te converteren: de DMA leest dan direct uit
+// het LVGL-buffer (zero-copy), in stukken van ChunkBytes.
+template <class Engine, size_t ChunkBytes = ILI9488_I80_CHUNK_BYTES, class Fmt = Ili9488PixelFormat>
+struct I80DmaTransport {
+  static_assert(ChunkBytes % 2 == 0, "chunk moet op een pixelgrens eindigen");
+
+  // LCD_CAM klokt elke byte zelf uit: geen GPIO-stores om te besparen
+  static constexpr bool kWrOnlyFill = false;
+
+  struct State {
+    uint8_t *stage[2] = {nullptr, nullptr};
+    size_t   fill     = 0;
+    int      cur      = 0;
+    uint8_t  ramwr    = 0x2C;
+  };
+
+  static State& state()
+  {
+    static State s;
+    return s;
+  }
+
+  // Mag vaker: de bus komt er maar één keer, de staging-buffers blijven na deinit() staan.
+  // false: geen DMA-geheugen voor de staging-buffers (bv. na grote LVGL-buffers);
+  // commando's werken dan wel, pixels() en color() laten de pixels vallen.
+  static bool init()
+  {
+    Engine::init(ChunkBytes);
+    if (!state().stage[0]) state().stage[0] = Engine::alloc(ChunkBytes);
+    if (!state().stage[1]) state().stage[1] = Engine::alloc(ChunkBytes);
+    return ready();
+  }
+
+  static bool ready()
+  {
+    return state().stage[0] && state().stage[1];
+  }
+
+  // LCD_CAM vrijgeven (bv. voor LovyanGFX); init() zet hem weer op
+  static void deinit()
+  {
+    Engine::deinit();
+  }
+
+  static void command(uint8_t cmd, const uint8_t *params = nullptr, size_t n = 0)
+  {
+    Engine::tx_param(cmd, params, n);
+  }
+
+  static void begin_ramwr(const Ili9488WindowCmd& c)
+  {
+    if (c.caset) {
+      const uint8_t caset[4] = { uint8_t(c.x1 >> 8), uint8_t(c.x1 & 0xFF), uint8_t(c.x2 >> 8), uint8_t(c.x2 & 0xFF) };
+      Engine::tx_param(0x2A, caset, 4);
+    }
+    if (c.paset) {
+      const uint8_t paset[4] = { uint8_t(c.y1 >> 8), uint8_t(c.y1 & 0xFF), uint8_t(c.y2 >> 8), uint8_t(c.y2 & 0xFF) };
+      Engine::tx_param(0x2B, paset, 4);
+    }
+
+    // RAMWR / RAMWRC gaat mee als commandofase van de eerste DMA-transfer
+    state().ramwr = c.ramwr;
+    state().fill  = 0;
+  }
+
+  static void begin_ramwr(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+  {
+    begin_ramwr(Ili9488WindowCmd::full(x, y, w, h));
+  }
+
+  static void pixels(const uint8_t *px_map, uint32_t count)
+  {
+    State& s = state();
+
+    if constexpr (Fmt::kRaw) {
+      flush();   // eventueel nog gestagede bytes eerst
+
+      size_t bytes = 2 * static_cast<size_t>(count);
+      while (bytes) {
+        const size_t n = (bytes < ChunkBytes) ? bytes : ChunkBytes;
+        Engine::tx_color(s.ramwr, px_map, n);
+        s.ramwr = 0x3C;
+        px_map += n;
+        bytes  -= n;
+      }
+      return;
+    }
+
+    if (!ready()) return;
+    while (count) {
+      uint32_t n = static_cast<uint32_t>((ChunkBytes - s.fill) / 2);
+      if (n > count) n = count;
+
+      uint8_t *dst = s.stage[s.cur] + s.fill;
+      for (uint32_t i = 0; i < n; i++) {
+        uint16_t c = Fmt::panel(px_map[2 * i + 0], px_map[2 * i + 1]);
+        dst[2 * i + 0] = c >> 8;
+        dst[2 * i + 1] = c & 0xFF;
+      }
+
+      s.fill += 2 * n;
+      px_map += 2 * n;
+      count  -= n;
+      if (s.fill == ChunkBytes) flush();
+    }
+  }
+
+  // Eén kleur: staging-buffer 1x vullen en dezelfde chunk herhaald versturen,
+  // de CPU hoeft dan niet per chunk opnieuw te schrijven
+  static void color(uint16_t color, uint32_t count)
+  {
+    State& s = state();
+    const uint16_t c = Fmt::fill(color);
+    if (!ready()) return;
+
+    flush();
+    Engine::wait_pending(0);   // beide buffers vrij, stage[cur] mag overschreven worden
+
+    const uint32_t per_chunk = static_cast<uint32_t>(ChunkBytes / 2);
+    const uint32_t n = (count < per_chunk) ? count : per_chunk;
+    uint8_t *dst = s.stage[s.cur];
+    for (uint32_t i = 0; i < n; i++) {
+      dst[2 * i + 0] = c >> 8;
+      dst[2 * i + 1] = c & 0xFF;
+    }
+
+    while (count) {
+      const uint32_t m = (count < per_chunk) ? count : per_chunk;
+      Engine::tx_color(s.ramwr, dst, 2 * static_cast<size_t>(m));
+      s.ramwr = 0x3C;
+      count  -= m;
+    }
+
+    // stage[cur] blijft in gebruik tot de DMA klaar is; verder in de andere
+    s.cur ^= 1;
+  }
+
+  static void end_ramwr()
+  {
+    flush();
+    Engine::wait_pending(0);
+  }
+
+private:
+  static void flush()
+  {
+    State& s = state();
+    if (s.fill == 0) return;
+
+    Engine::tx_color(s.ramwr, s.stage[s.cur], s.fill);
+    s.ramwr = 0x3C;
+
+    // andere buffer pas vullen als de DMA er klaar mee is
+    s.cur ^= 1;
+    s.fill = 0;
+    Engine::wait_pending(1);
+  }
+};
+
+#if defined(ILI9488_TRANSPORT_I80)
+#if defined(ESP_PLATFORM)
+using LcdTransport = I80DmaTransport<lcdbus::EspLcdI80Engine<Ili9488Pins, ILI9488_I80_PCLK_HZ>>;
+#else
+using LcdTransport = I80DmaTransport<lcdbus::FakeDmaEngine>;
+#endif
+#else
+using LcdTransport = BitBangTransport;
+#endif
+
 inline void ili9488_set_rotation(uint8_t r) {
   uint8_t madctl = 0;
 
@@ -83,125 +541,304 @@ inline void ili9488_set_rotation(uint8_t r) {
       break;
   }
 
-  lcd_writeCommand(0x36);
-  lcd_writeData(madctl);
+  LcdTransport::command(0x36, &madctl, 1);
+
+  // MV wisselt kolommen en pagina's: window opnieuw opbouwen bij de volgende burst
+  ili9488_window().rows = (r & 1) ? ILI9488_WIDTH : ILI9488_HEIGHT;
+  ili9488_window().invalidate();
 }
 
+// Logische afmetingen in de huidige rotatie
+inline uint16_t ili9488_width()  { return ili9488_window().rows == ILI9488_WIDTH ? ILI9488_HEIGHT : ILI9488_WIDTH; }
+inline uint16_t ili9488_height() { return ili9488_window().rows; }
+
 inline void ili9488_set_window(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
 {
-  uint16_t x2 = x + w - 1;
-  uint16_t y2 = y + h - 1;
+  ili9488_window().invalidate();
+  LcdTransport::begin_ramwr(Ili9488WindowCmd::full(x, y, w, h));
+  LcdTransport::end_ramwr();
+}
 
-  // Column address set
-  lcd_writeCommand(0x2A);
-  lcd_writeData(x >> 8);
-  lcd_writeData(x & 0xFF);
-  lcd_writeData(x2 >> 8);
-  lcd_writeData(x2 & 0xFF);
+// ---- Hardware vertical scroll ----
+// Werkt op de 480 gate-lijnen (geheugenrijen, ILI9488_HEIGHT). In landscape
+// (MADCTL MV) lopen die over de schermbreedte: scrollen schuift het beeld dan
+// horizontaal. TFA + VSA + BFA moet 480 zijn.
+inline void ili9488_scroll_define(uint16_t tfa, uint16_t vsa, uint16_t bfa)
+{
+  const uint8_t p[6] = { uint8_t(tfa >> 8), uint8_t(tfa & 0xFF),
+                         uint8_t(vsa >> 8), uint8_t(vsa & 0xFF),
+                         uint8_t(bfa >> 8), uint8_t(bfa & 0xFF) };
+  LcdTransport::command(0x33, p, 6);   // VSCRDEF
+}
 
-  // Page address set
-  lcd_writeCommand(0x2B);
-  lcd_writeData(y >> 8);
-  lcd_writeData(y & 0xFF);
-  lcd_writeData(y2 >> 8);
-  lcd_writeData(y2 & 0xFF);
+// Geheugenrij die als eerste lijn van het scrollgebied getoond wordt
+inline void ili9488_scroll_start(uint16_t vsp)
+{
+  const uint8_t p[2] = { uint8_t(vsp >> 8), uint8_t(vsp & 0xFF) };
+  LcdTransport::command(0x37, p, 2);   // VSCRSADD
+}
 
-  // RAMWR
-  lcd_writeCommand(0x2C);
+// Terug naar normaal beeld (NORON); wat in het scrollgebied staat moet opnieuw getekend
+inline void ili9488_scroll_off()
+{
+  LcdTransport::command(0x13);
 }
 
-inline void ili9488_init()
+// ==== INIT-SEQUENTIE (tabel) ====
+// Per stap: commando, parameters en de minimale tijd (datasheet) voordat het
+// volgende commando mag. Geen vaste delay(120)'s meer: de sequencer stuurt een
+// stap pas als zijn tijd gekomen is, en de caller doet in de tussentijd iets
+// nuttigs (backlight, lv_init, UI opbouwen) en pollt af en toe.
+struct Ili9488InitStep {
+  uint8_t  cmd;
+  uint8_t  n;           // aantal parameters in params
+  uint8_t  params[3];
+  uint16_t wait_ms;     // minimaal tot het volgende commando
+};
+
+// Na (power-on of hardware) reset: 120 ms voordat de controller commando's aanneemt
+constexpr uint16_t ILI9488_RESET_WAIT_MS = 120;
+
+constexpr Ili9488InitStep ILI9488_INIT_TABLE[] = {
+  { 0x01, 0, {},     120 },   // SWRESET: 120 ms voor SLPOUT (5 ms voor andere commando's)
+  { 0x11, 0, {},     5   },   // SLPOUT: 5 ms voor het volgende commando
+  { 0x3A, 1, {0x55}, 0   },   // COLMOD: 16-bit RGB565
+  { Ili9488PixelFormat::kInvon, 0, {}, 0 },   // INVOFF bij software-inversie, INVON native
+  { 0x29, 0, {},     0   },   // DISPON
+};
+
+constexpr size_t ILI9488_INIT_STEPS = sizeof(ILI9488_INIT_TABLE) / sizeof(ILI9488_INIT_TABLE[0]);
+
+// Som van alle verplichte wachttijden in de tabel (zonder reset)
+constexpr uint32_t ili9488_init_min_ms(const Ili9488InitStep *t = ILI9488_INIT_TABLE, size_t n = ILI9488_INIT_STEPS)
 {
-  // Datapinnen + control-pinnen als output
-  for (int i = 0; i < 8; i++) {
-    pinMode(lcd_data_pins[i], OUTPUT);
-    digitalWrite(lcd_data_pins[i], LOW);
+  return n == 0 ? 0 : t[0].wait_ms + ili9488_init_min_ms(t + 1, n - 1);
+}
+
+constexpr bool ili9488_init_table_valid(const Ili9488InitStep *t = ILI9488_INIT_TABLE, size_t n = ILI9488_INIT_STEPS)
+{
+  return n == 0 || (t[0].n <= sizeof(t[0].params) && ili9488_init_table_valid(t + 1, n - 1));
+}
+
+static_assert(ili9488_init_table_valid(), "init-tabel: te veel parameters in een stap");
+
+// Niet-blokkerende uitvoering van een init-tabel. Tijden in ms (millis()).
+struct Ili9488InitSequencer {
+  const Ili9488InitStep *table = ILI9488_INIT_TABLE;
+  size_t   count    = ILI9488_INIT_STEPS;
+  size_t   next     = 0;
+  uint32_t ready_at = 0;      // vroegste tijd voor de volgende stap
+  bool     running  = false;
+
+  void start(uint32_t first_at)
+  {
+    next     = 0;
+    ready_at = first_at;
+    running  = true;
+  }
+
+  bool done() const { return !running; }
+
+  // Hoelang de volgende stap nog moet wachten (0 = nu)
+  uint32_t wait_ms(uint32_t now) const
+  {
+    return (!running || int32_t(now - ready_at) >= 0) ? 0 : ready_at - now;
   }
-  pinMode(LCD_CS, OUTPUT);
-  pinMode(LCD_RS, OUTPUT);
-  pinMode(LCD_WR, OUTPUT);
-  digitalWrite(LCD_CS, HIGH);
-  digitalWrite(LCD_RS, HIGH);
-  digitalWrite(LCD_WR, HIGH);
+
+  // Stuurt alle stappen waarvan de tijd gekomen is; true als de tabel klaar is
+  template <class Transport = LcdTransport>
+  bool poll(uint32_t now)
+  {
+    while (running && int32_t(now - ready_at) >= 0) {
+      const Ili9488InitStep &s = table[next];
+      Transport::command(s.cmd, s.n ? s.params : nullptr, s.n);
+      ready_at = now + s.wait_ms;
+      if (++next == count) running = false;
+    }
+    return !running;
+  }
+};
+
+inline Ili9488InitSequencer& ili9488_init_seq()
+{
+  static Ili9488InitSequencer q;
+  return q;
+}
+
+// Start de init: bus klaarzetten, eventueel reset-puls, tabel inplannen.
+// Daarna ili9488_init_poll() aanroepen tussen ander boot-werk door.
+// false: de transport kreeg zijn buffers niet, het paneel blijft leeg.
+inline bool ili9488_init_begin()
+{
+  const bool ok = LcdTransport::init();
+  ili9488_window().invalidate();
 
 #if (LCD_RST >= 0)
   pinMode(LCD_RST, OUTPUT);
   digitalWrite(LCD_RST, LOW);
-  delay(10);
+  delayMicroseconds(10);
   digitalWrite(LCD_RST, HIGH);
-  delay(120);
+  ili9488_init_seq().start(millis() + ILI9488_RESET_WAIT_MS);
 #else
-  // RST hard aan 3V3
-  delay(120);
+  // RST hard aan 3V3: de power-on reset liep al vanaf boot, millis() telt vanaf dan
+  const uint32_t now = millis();
+  ili9488_init_seq().start(now > ILI9488_RESET_WAIT_MS ? now : ILI9488_RESET_WAIT_MS);
 #endif
+  return ok;
+}
 
-  // Software reset
-  lcd_writeCommand(0x01);
-  delay(120);
-
-  // Sleep out
-  lcd_writeCommand(0x11);
-  delay(120);
-
-  // 16-bit pixel formaat RGB565
-  lcd_writeCommand(0x3A);
-  lcd_writeData(0x55);
-
-  // Memory Access Control: portret, geen spiegeling, RGB (BGR=0, MV=0)
-  // lcd_writeCommand(0x36);
-  // lcd_writeData(0x48);
-
-  // Display inversion OFF (heel belangrijk om zwart/wit omkering uit te zetten)
-  lcd_writeCommand(0x20);  // of 0x21, afhankelijk van jouw werkende situatie
-
-  // Display on
-  lcd_writeCommand(0x29);
-  delay(20);
-
-  ili9488_set_rotation(1);
+// Laat de rotatie pas na de tabel zetten (set_rotation werkt ook de window-tracker bij)
+inline bool ili9488_init_poll()
+{
+  Ili9488InitSequencer &q = ili9488_init_seq();
+  if (q.done()) return true;
+  if (q.poll(millis())) ili9488_set_rotation(1);
+  return q.done();
 }
 
-inline void ili9488_fill_screen(uint16_t color)
+// Bus loslaten voor een andere driver (LovyanGFX claimt ook LCD_CAM); een
+// volgende ili9488_init_begin() zet hem weer op
+inline void ili9488_release()
 {
-  // compenseer paneel-inversie
-  uint16_t c = ~color;
+  LcdTransport::deinit();
+  ili9488_window().invalidate();
+}
 
-  ili9488_set_window(0, 0, 320, 480);
-  uint32_t total = 320UL * 480UL;
-  for (uint32_t i = 0; i < total; i++) {
-    lcd_writeColor(c);
+// Rest van de init blokkerend afmaken (delay() laat andere taken draaien)
+inline void ili9488_init_finish()
+{
+  while (!ili9488_init_poll()) {
+    delay(ili9488_init_seq().wait_ms(millis()));
   }
 }
 
-
-// LVGL buffer schrijven: px_map zijn bytes in RGB565 (little endian)
-inline void ili9488_push_pixels(uint16_t x, uint16_t y,
-                                uint16_t w, uint16_t h,
-                                const uint8_t *px_map)
+inline void ili9488_init()
 {
-  ili9488_set_window(x, y, w, h);
+  ili9488_init_begin();
+  ili9488_init_finish();
+}
 
-  uint32_t total = (uint32_t)w * h;
-  for (uint32_t i = 0; i < total; i++) {
-    uint8_t lo = px_map[2 * i + 0];
-    uint8_t hi = px_map[2 * i + 1];
+// ---- RAMWR burst: window 1x zetten, daarna alleen data + WR ----
+//
+//   ili9488_begin_write(x, y, w, h);
+//   ili9488_write_pixels(px, n);   // mag meerdere keren, totaal w*h pixels
+//   ili9488_end_write();
+//
+// CS en RS togglen dus een vast aantal keer per flush, niet meer per byte.
+// Sluit het gebied aan op het vorige (zelfde kolommen, volgende rij), dan wordt
+// alleen RAMWRC gestuurd; zie Ili9488WindowTracker.
+
+inline void ili9488_begin_write(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+  LcdTransport::begin_ramwr(ili9488_window().plan(x, y, w, h));
+}
 
-    // maak 16-bit kleur uit LVGL
-    uint16_t c = (static_cast<uint16_t>(hi) << 8) | lo;
+// px_map zijn bytes in RGB565 zoals LVGL ze rendert (LE, of BE in native-pixelmodus)
+inline void ili9488_write_pixels(const uint8_t *px_map, uint32_t count)
+{
+  LcdTransport::pixels(px_map, count);
+  ili9488_window().advance(count);
+}
 
-    // compenseer paneel-inversie
-    c = ~c;
+// Zelfde kleur count keer (kleur zoals LVGL hem ziet, inversie gebeurt in de transport)
+inline void ili9488_write_color(uint16_t color, uint32_t count)
+{
+  LcdTransport::color(color, count);
+  ili9488_window().advance(count);
+}
 
-    lcd_writeColor(c);
-  }
+inline void ili9488_end_write()
+{
+  LcdTransport::end_ramwr();
 }
 
+// ---- Effen vlakken ----
+// Achtergrond, sidebar en knoppen zijn vaak één kleur. Zo'n gebied gaat als
+// herhaalde kleur de bus op (bit-bang: alleen WR togglen als hoge en lage byte
+// gelijk zijn, DMA: één gevulde chunk herhaald) i.p.v. het buffer te streamen.
+
+// Telt per scherm hoeveel pixels langs welk pad gingen
+struct Ili9488FillStats {
+  uint32_t areas;        // geflushte gebieden
+  uint32_t solid_areas;  // daarvan effen
+  uint32_t px_streamed;  // pixels uit het buffer gestreamd
+  uint32_t px_solid;     // pixels als herhaalde kleur
+  uint32_t px_strobe;    // daarvan alleen WR (hoge byte == lage byte); alleen bit-bang
+
+  // Bit-bang: gestreamde pixel = 2 bytes x 3 stores, WR-only = 2 x 2 stores
+  uint32_t stores_saved() const { return 2 * px_strobe; }
+};
 
+inline Ili9488FillStats& ili9488_fill_stats()
+{
+  static Ili9488FillStats s;
+  return s;
+}
 
+// Staat er in het hele buffer één kleur? Eerst wat steekproeven (eerste,
+// middelste, laatste pixel), dan per 32-bit woord; stopt bij het eerste verschil.
+inline bool ili9488_area_solid(const uint8_t *px_map, uint32_t count, uint16_t &color)
+{
+  if (count == 0) return false;
+
+  const uint8_t b0 = px_map[0], b1 = px_map[1];
+  const uint32_t mid = 2 * (count / 2), last = 2 * (count - 1);
+  if (px_map[mid] != b0 || px_map[mid + 1] != b1 || px_map[last] != b0 || px_map[last + 1] != b1) return false;
+
+  const uint32_t pattern = b0 | (b1 << 8) | (uint32_t(b0) << 16) | (uint32_t(b1) << 24);
+  const uint32_t words = count / 2;
+  for (uint32_t i = 0; i < words; i++) {
+    uint32_t w;
+    memcpy(&w, px_map + 4 * i, 4);   // LVGL-buffers zijn aligned; memcpy wordt één load
+    if (w != pattern) return false;
+  }
+  if ((count & 1) && (px_map[last] != b0 || px_map[last + 1] != b1)) return false;
 
+  color = Ili9488PixelFormat::lvgl(b0, b1);
+  return true;
+}
 
+// Eén kleur over een gebied (kleur zoals LVGL hem ziet)
+inline void ili9488_fill_area(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+  const uint32_t n = (uint32_t)w * h;
+  const uint16_t c = Ili9488PixelFormat::fill(color);
+
+  Ili9488FillStats &st = ili9488_fill_stats();
+  st.areas++;
+  st.solid_areas++;
+  st.px_solid += n;
+  if (LcdTransport::kWrOnlyFill && (c >> 8) == (c & 0xFF)) st.px_strobe += n;
+
+  ili9488_begin_write(x, y, w, h);
+  ili9488_write_color(color, n);
+  ili9488_end_write();
+}
 
+inline void ili9488_fill_screen(uint16_t color)
+{
+  ili9488_fill_area(0, 0, ili9488_width(), ili9488_height(), color);
+}
 
+// LVGL buffer schrijven: px_map zijn bytes in RGB565 (LE, of BE in native-pixelmodus).
+// Effen gebieden gaan automatisch via ili9488_fill_area.
+inline void ili9488_push_pixels(uint16_t x, uint16_t y,
+                                uint16_t w, uint16_t h,
+                                const uint8_t *px_map)
+{
+  const uint32_t n = (uint32_t)w * h;
 
+  uint16_t color;
+  if (ili9488_area_solid(px_map, n, color)) {
+    ili9488_fill_area(x, y, w, h, color);
+    return;
+  }
 
+  Ili9488FillStats &st = ili9488_fill_stats();
+  st.areas++;
+  st.px_streamed += n;
 
+  ili9488_begin_write(x, y, w, h);
+  ili9488_write_pixels(px_map, n);
+  ili9488_end_write();
+}
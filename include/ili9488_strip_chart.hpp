@@ -0,0 +1,140 @@
+// ili9488_strip_chart.hpp - scrollende strip-chart via hardware vertical scroll
+#pragma once
+#include "ili9488_driver.hpp"
+
+// Live trace zonder chart-repaint: elke sample is één nieuwe kolom pixels, daarna
+// schuift VSCRSADD het scrollgebied één lijn op zodat de oudste kolom links staat.
+//
+// Alleen in rotatie 1 (MADCTL 0x28): logische x = geheugenrij, dus de scrollband
+// x0..x0+w-1 is in hardware altijd een band over de HELE schermhoogte; het
+// scrollgebied kan niet tot de plotrijen beperkt worden. Daarom schrijft push()
+// alleen de plotrijen y0..y0+h-1, en zet push_around wat LVGL boven en onder het
+// plotgebied in de band tekent (titel, assen, infolabels) in de geheugenkolom die
+// op die schermpositie staat. Na elke sample moet de caller die stroken opnieuw
+// laten renderen: tot dan staan ze één pixel verschoven.
+struct Ili9488StripChart {
+  uint16_t x0 = 0, w = 0;       // scrollband (logische x)
+  uint16_t y0 = 0, h = 0;       // plotgebied binnen een kolom
+  uint16_t fg = 0xFFFF;         // kleuren zoals LVGL ze ziet
+  uint16_t bg = 0x0000;
+  uint16_t head   = 0;          // geheugenkolom (t.o.v. x0) voor de volgende sample
+  int16_t  last_y = -1;         // vorige plot-y, voor een doorlopende lijn
+  bool     active = false;
+
+  // Plotgebied leegmaken en scrollgebied instellen. Bij head = 0 is de afbeelding
+  // geheugen -> scherm de identiteit, dus wat LVGL al in de band tekende blijft staan.
+  void begin(uint16_t band_x, uint16_t band_w, uint16_t plot_y, uint16_t plot_h,
+             uint16_t fg_color, uint16_t bg_color)
+  {
+    x0 = band_x; w = band_w; y0 = plot_y; h = plot_h;
+    fg = fg_color; bg = bg_color;
+    head = 0;
+    last_y = -1;
+
+    ili9488_fill_area(x0, y0, w, h, bg);
+    ili9488_scroll_define(x0, w, ILI9488_HEIGHT - x0 - w);
+    ili9488_scroll_start(x0);
+    active = true;
+  }
+
+  // Normaal beeld terug; de caller tekent de band daarna opnieuw
+  void end()
+  {
+    ili9488_scroll_off();
+    active = false;
+  }
+
+  // Waarde -> plot-y (vmax bovenaan)
+  int16_t y_of(int32_t v, int32_t vmin, int32_t vmax) const
+  {
+    if (v < vmin) v = vmin;
+    if (v > vmax) v = vmax;
+    const int32_t span = (vmax > vmin) ? (vmax - vmin) : 1;
+    return static_cast<int16_t>(y0 + (h - 1) - (v - vmin) * (h - 1) / span);
+  }
+
+  // Eén sample: kolom op de schrijfpositie tekenen en het beeld één lijn doorschuiven.
+  // Kost h pixels in één venster + 2 korte commando's i.p.v. een chart-repaint.
+  void push(int32_t v, int32_t vmin, int32_t vmax)
+  {
+    const int16_t y = y_of(v, vmin, vmax);
+    int16_t top = y, bot = y;
+    if (last_y >= 0) {
+      if (last_y < top) top = last_y;
+      if (last_y > bot) bot = last_y;
+    }
+    last_y = y;
+
+    ili9488_begin_write(x0 + head, y0, 1, h);
+    ili9488_write_color(bg, top - y0);
+    ili9488_write_color(fg, bot - top + 1);
+    ili9488_write_color(bg, y0 + h - bot - 1);
+    ili9488_end_write();
+
+    head = (head + 1 == w) ? 0 : head + 1;
+    ili9488_scroll_start(x0 + head);
+  }
+
+  // Logische x waarop geheugenkolom x0 + col nu zichtbaar is
+  uint16_t screen_x(uint16_t col) const
+  {
+    return x0 + (col + w - head) % w;
+  }
+
+  // Geheugenkolom (t.o.v. x0) die nu op logische x sx staat; inverse van screen_x
+  uint16_t memory_col(uint16_t sx) const
+  {
+    return (sx - x0 + head) % w;
+  }
+
+  // LVGL-gebied flushen. Buiten de band gaat het ongewijzigd naar het paneel, in de
+  // band vallen de plotrijen weg (daar staat de trace) en gaan de rijen erboven en
+  // eronder naar de geheugenkolommen die op die schermposities staan. Elk deel is
+  // één venster over alle rijen van het deel; het geschoven deel van de band wrapt
+  // hooguit één keer, dus dat zijn er per rijbereik maximaal twee.
+  // Zonder actieve strip gewoon ili9488_push_pixels.
+  void push_around(uint16_t x, uint16_t y, uint16_t aw, uint16_t ah, const uint8_t *px_map) const
+  {
+    const uint16_t xe = x + aw, ye = y + ah, be = x0 + w;
+    if (!active || xe <= x0 || x >= be) {
+      ili9488_push_pixels(x, y, aw, ah, px_map);
+      return;
+    }
+
+    const uint16_t left  = (x < x0) ? x0 - x : 0;                  // pixels links van de band
+    const uint16_t right = (xe > be) ? xe - be : 0;                // pixels rechts ervan
+    if (left)  write_part(x, y, left, ah, px_map, aw, 0);
+    if (right) write_part(be, y, right, ah, px_map, aw, aw - right);
+
+    // Bandkolommen van het gebied, boven en onder het plotgebied
+    const uint16_t bx = (x > x0) ? x : x0;
+    const uint16_t bw = ((xe < be) ? xe : be) - bx;
+    const uint16_t top_end   = (ye < y0) ? ye : y0;
+    const uint16_t bot_start = (y > y0 + h) ? y : y0 + h;
+    if (top_end > y)    write_band(bx, bw, y, top_end, px_map, x, y, aw);
+    if (ye > bot_start) write_band(bx, bw, bot_start, ye, px_map, x, y, aw);
+  }
+
+private:
+  // pw x ph pixels uit px_map (rijbreedte aw, vanaf kolom off) als één venster op (dx, dy)
+  static void write_part(uint16_t dx, uint16_t dy, uint16_t pw, uint16_t ph,
+                         const uint8_t *px_map, uint16_t aw, uint16_t off)
+  {
+    ili9488_begin_write(dx, dy, pw, ph);
+    for (uint16_t r = 0; r < ph; r++) ili9488_write_pixels(px_map + 2UL * (aw * r + off), pw);
+    ili9488_end_write();
+  }
+
+  // Schermkolommen bx..bx+bw-1 van rijen r0..r1-1 naar hun geheugenkolommen
+  // (px_map begint op (x, y), breedte aw)
+  void write_band(uint16_t bx, uint16_t bw, uint16_t r0, uint16_t r1,
+                  const uint8_t *px_map, uint16_t x, uint16_t y, uint16_t aw) const
+  {
+    const uint8_t *rows = px_map + 2UL * aw * (r0 - y);
+    const uint16_t off = bx - x;
+    const uint16_t m0  = memory_col(bx);
+    const uint16_t n1  = (bw < w - m0) ? bw : w - m0;   // tot het einde van het geheugen
+    write_part(x0 + m0, r0, n1, r1 - r0, rows, aw, off);
+    if (bw > n1) write_part(x0, r0, bw - n1, r1 - r0, rows, aw, off + n1);
+  }
+};
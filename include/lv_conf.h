@@ -69,7 +69,10 @@
 
 #if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
     /** Size of memory available for `lv_malloc()` in bytes (>= 2kB) */
+    /* Host-build (64-bit pointers) geeft een grotere waarde mee via -DLV_MEM_SIZE */
+    #ifndef LV_MEM_SIZE
     #define LV_MEM_SIZE (64 * 1024U)          /**< [bytes] */
+    #endif
 
     /** Size of the memory expand for `lv_malloc()` in bytes */
     #define LV_MEM_POOL_EXPAND_SIZE 0
@@ -107,7 +110,18 @@
  * - LV_OS_MQX
  * - LV_OS_SDL2
  * - LV_OS_CUSTOM */
-#define LV_USE_OS   LV_OS_NONE
+/* -DDISPLAY_DUAL_CORE=1: renderen met 2 SW draw units (één per core). Daarvoor
+ * moet LVGL een OS hebben: FreeRTOS op het target, pthreads in de host-build. */
+#ifndef DISPLAY_DUAL_CORE
+    #define DISPLAY_DUAL_CORE 0
+#endif
+#if DISPLAY_DUAL_CORE && defined(ESP_PLATFORM)
+    #define LV_USE_OS   LV_OS_FREERTOS
+#elif DISPLAY_DUAL_CORE
+    #define LV_USE_OS   LV_OS_PTHREAD
+#else
+    #define LV_USE_OS   LV_OS_NONE
+#endif
 
 #if LV_USE_OS == LV_OS_CUSTOM
     #define LV_OS_CUSTOM_INCLUDE <stdint.h>
@@ -192,7 +206,11 @@
     /** Set number of draw units.
      *  - > 1 requires operating system to be enabled in `LV_USE_OS`.
      *  - > 1 means multiple threads will render the screen in parallel. */
-    #define LV_DRAW_SW_DRAW_UNIT_CNT    1
+    #if DISPLAY_DUAL_CORE
+        #define LV_DRAW_SW_DRAW_UNIT_CNT    2
+    #else
+        #define LV_DRAW_SW_DRAW_UNIT_CNT    1
+    #endif
 
     /** Use Arm-2D to accelerate software (sw) rendering. */
     #define LV_USE_DRAW_ARM2D_SYNC      0
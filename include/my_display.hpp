@@ -49,7 +49,7 @@ public:
       p.offset_y = 0;
 
       p.readable   = false;          // RD = -1, dus niet lezen
-      p.invert     = false;
+      p.invert     = true;           // glas is geïnverteerd: INVON, net als de native-pixelmodus
       p.rgb_order  = false;
       p.dlen_16bit = true;           // 16-bit RGB565 (zoals in je test met 0x3A / 0x55)
       p.bus_shared = false;
@@ -61,4 +61,5 @@ public:
   }
 };
 
+// Gedefinieerd in src/display_backend.cpp
 extern LGFX gfx;
@@ -0,0 +1,287 @@
+// arc_gauge.hpp - voorgerasterde ringmeter: ring één keer rasteren, per update alleen de hoekdelta
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <math.h>
+
+namespace arcgauge {
+
+// Inclusieve rechthoek in pixels, relatief aan de linkerbovenhoek van de ring
+struct Rect {
+  int16_t x1, y1, x2, y2;
+};
+
+constexpr Rect EMPTY = { INT16_MAX, INT16_MAX, INT16_MIN, INT16_MIN };
+
+inline bool empty(const Rect& r) { return r.x1 > r.x2 || r.y1 > r.y2; }
+
+inline void join(Rect& a, const Rect& b) {
+  if (b.x1 < a.x1) a.x1 = b.x1;
+  if (b.y1 < a.y1) a.y1 = b.y1;
+  if (b.x2 > a.x2) a.x2 = b.x2;
+  if (b.y2 > a.y2) a.y2 = b.y2;
+}
+
+using AllocFn = void* (*)(size_t);
+using FreeFn  = void (*)(void*);
+
+// ---- Ring-geometrie ----
+// Anti-aliased ring van size x size met dikte `width`, als A8-dekking. Hoeken zoals
+// LVGL: 0 graden = 3 uur, met de klok mee; `rotation` is waar stap 1 begint.
+// Stap s (1..steps) dekt [rotation + (s-1)*360/steps, rotation + s*360/steps).
+// De ringpixels staan per stap gesorteerd in `order`, zodat een waardewijziging
+// alleen de pixels van de stappen ertussen raakt. Eén Ring kan door meerdere
+// gauges van dezelfde maat gedeeld worden.
+struct Ring {
+  uint16_t size = 0, width = 0, rotation = 0, steps = 0;
+  uint32_t pixels = 0;            // pixels met dekking > 0
+
+  uint8_t*  coverage = nullptr;   // size * size, A8
+  uint16_t* order    = nullptr;   // pixeloffsets (y * size + x), op stap gesorteerd
+  uint32_t* begin    = nullptr;   // steps + 1: stap s = order[begin[s-1] .. begin[s])
+  Rect*     box      = nullptr;   // steps: omhullende per stap
+
+  // size <= 256 (offsets zijn 16 bit); false als het niet past of alloceren faalt
+  bool init(uint16_t size_, uint16_t width_, uint16_t rotation_, uint16_t steps_,
+            AllocFn alloc = malloc, FreeFn release_fn = free);
+  void release(FreeFn release_fn = free);
+
+  // Stap van pixel (x, y); 0 = geen ringpixel
+  uint16_t step_of(int x, int y) const;
+
+  // Rond uiteinde zoals arc_rounded van lv_arc: een schijf met diameter `width` op
+  // het midden van de ringdikte, op de grens na stap b (b = 0: het begin bij rotation)
+  struct Cap {
+    float cx, cy;
+    Rect  box;
+  };
+  Cap cap(uint16_t b) const;
+  uint8_t cap_coverage(const Cap& c, int x, int y) const;   // binnen de ring geknipt
+
+  // Indicatorpixel bij waarde v, volledig berekend: de stappen 1..v plus de ronde
+  // uiteinden bij 0 en v zolang de ring niet leeg of vol is
+  uint8_t indicator_at(int x, int y, uint16_t v) const;
+};
+
+inline uint16_t Ring::step_of(int x, int y) const {
+  if (coverage[y * size + x] == 0) return 0;
+  const float c   = size * 0.5f;
+  float deg = atan2f(y + 0.5f - c, x + 0.5f - c) * (180.0f / 3.14159265f) - rotation;
+  while (deg < 0.0f) deg += 360.0f;
+  while (deg >= 360.0f) deg -= 360.0f;
+  const uint32_t s = (uint32_t)(deg * steps / 360.0f) + 1;
+  return (uint16_t)(s > steps ? steps : s);
+}
+
+inline Ring::Cap Ring::cap(uint16_t b) const {
+  const float c  = size * 0.5f;
+  const float rm = c - width * 0.5f;
+  const float a  = (rotation + b * 360.0f / steps) * (3.14159265f / 180.0f);
+  Cap k;
+  k.cx = c + rm * cosf(a);
+  k.cy = c + rm * sinf(a);
+  const float r = width * 0.5f + 1.0f;
+  const int x1 = (int)floorf(k.cx - r), y1 = (int)floorf(k.cy - r);
+  const int x2 = (int)ceilf(k.cx + r),  y2 = (int)ceilf(k.cy + r);
+  k.box = { (int16_t)(x1 < 0 ? 0 : x1), (int16_t)(y1 < 0 ? 0 : y1),
+            (int16_t)(x2 >= size ? size - 1 : x2), (int16_t)(y2 >= size ? size - 1 : y2) };
+  return k;
+}
+
+inline uint8_t Ring::cap_coverage(const Cap& k, int x, int y) const {
+  const float dx = x + 0.5f - k.cx, dy = y + 0.5f - k.cy;
+  float a = width * 0.5f - sqrtf(dx * dx + dy * dy) + 0.5f;
+  a = a < 0.0f ? 0.0f : (a > 1.0f ? 1.0f : a);
+  const uint8_t v = (uint8_t)(a * 255.0f + 0.5f);
+  const uint8_t r = coverage[y * size + x];
+  return v < r ? v : r;
+}
+
+inline uint8_t Ring::indicator_at(int x, int y, uint16_t v) const {
+  const uint16_t s = step_of(x, y);
+  uint8_t a = (s && s <= v) ? coverage[y * size + x] : 0;
+  if (v > 0 && v < steps) {
+    const uint8_t b = cap_coverage(cap(0), x, y), e = cap_coverage(cap(v), x, y);
+    if (b > a) a = b;
+    if (e > a) a = e;
+  }
+  return a;
+}
+
+inline bool Ring::init(uint16_t size_, uint16_t width_, uint16_t rotation_, uint16_t steps_,
+                       AllocFn alloc, FreeFn release_fn) {
+  release(release_fn);
+  if (size_ == 0 || size_ > 256 || width_ == 0 || steps_ == 0) return false;
+  size = size_;
+  width = width_;
+  rotation = (uint16_t)(rotation_ % 360);
+  steps = steps_;
+
+  const uint32_t n = (uint32_t)size * size;
+  coverage = (uint8_t*)alloc(n);
+  begin    = (uint32_t*)alloc((steps + 1u) * sizeof(uint32_t));
+  box      = (Rect*)alloc(steps * sizeof(Rect));
+  if (!coverage || !begin || !box) {
+    release(release_fn);
+    return false;
+  }
+
+  // Dekking per pixel: afstand van het pixelmidden tot de twee randen, 1 px AA
+  const float r_out = size * 0.5f;
+  const float r_in  = r_out - width;
+  auto clamp01 = [](float v) { return v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v); };
+  pixels = 0;
+  for (int y = 0; y < size; y++) {
+    for (int x = 0; x < size; x++) {
+      const float dx = x + 0.5f - r_out, dy = y + 0.5f - r_out;
+      const float d  = sqrtf(dx * dx + dy * dy);
+      const float a  = clamp01(r_out - d + 0.5f) - clamp01(r_in - d + 0.5f);
+      const uint8_t v = (uint8_t)(a * 255.0f + 0.5f);
+      coverage[y * size + x] = v;
+      if (v) pixels++;
+    }
+  }
+
+  order = (uint16_t*)alloc(pixels * sizeof(uint16_t));
+  if (!order) {
+    release(release_fn);
+    return false;
+  }
+
+  // Counting sort op stap; begin[] eerst als teller, dan als startindex
+  for (uint32_t s = 0; s <= steps; s++) begin[s] = 0;
+  for (uint32_t s = 0; s < steps; s++) box[s] = EMPTY;
+  for (int y = 0; y < size; y++) {
+    for (int x = 0; x < size; x++) {
+      const uint16_t s = step_of(x, y);
+      if (!s) continue;
+      begin[s]++;
+      join(box[s - 1], Rect{ (int16_t)x, (int16_t)y, (int16_t)x, (int16_t)y });
+    }
+  }
+  for (uint32_t s = 1; s <= steps; s++) begin[s] += begin[s - 1];
+
+  // Tweede ronde: vullen vanaf het begin van elke stap (begin[s-1] schuift op en
+  // staat daarna op het begin van stap s; één keer terugschuiven herstelt alles)
+  for (int y = 0; y < size; y++) {
+    for (int x = 0; x < size; x++) {
+      const uint16_t s = step_of(x, y);
+      if (s) order[begin[s - 1]++] = (uint16_t)(y * size + x);
+    }
+  }
+  for (uint32_t s = steps; s > 0; s--) begin[s] = begin[s - 1];
+  begin[0] = 0;
+  return true;
+}
+
+inline void Ring::release(FreeFn release_fn) {
+  release_fn(coverage);
+  release_fn(order);
+  release_fn(begin);
+  release_fn(box);
+  coverage = nullptr;
+  order = nullptr;
+  begin = nullptr;
+  box = nullptr;
+  pixels = 0;
+}
+
+// ---- Gauge ----
+// Eigen A8-buffer met de indicator (dekking van de ring tot en met de huidige stap,
+// met ronde uiteinden, elders 0). set() schrijft alleen de pixels van de stappen
+// tussen oude en nieuwe waarde en van de uiteinden die verschuiven, en geeft de
+// omhullenden van wat veranderde, per kwart van de ring zodat een grote sprong
+// geen rechthoek over het hele gat in het midden oplevert.
+struct Gauge {
+  static constexpr int MAX_DIRTY = 4;
+
+  const Ring* ring      = nullptr;
+  uint8_t*    indicator = nullptr;   // ring->size^2, A8
+  uint16_t    value     = 0;         // 0..ring->steps
+  uint32_t    written   = 0;         // pixels geschreven bij de laatste set()
+
+  bool init(const Ring& r, AllocFn alloc = malloc) {
+    ring = &r;
+    indicator = (uint8_t*)alloc((uint32_t)r.size * r.size);
+    if (!indicator) return false;
+    for (uint32_t i = 0; i < (uint32_t)r.size * r.size; i++) indicator[i] = 0;
+    value = 0;
+    return true;
+  }
+
+  void release(FreeFn release_fn = free) {
+    release_fn(indicator);
+    indicator = nullptr;
+  }
+
+  // Geeft het aantal rechthoeken in `dirty` (0 als de waarde niet wijzigt)
+  int set(int v, Rect* dirty) {
+    written = 0;
+    if (v < 0) v = 0;
+    if (v > ring->steps) v = ring->steps;
+    if (v == value) return 0;
+
+    const uint16_t old = value;
+    const uint32_t lo = v > old ? old : (uint32_t)v;   // stappen lo+1 .. hi wijzigen
+    const uint32_t hi = v > old ? (uint32_t)v : old;
+    const bool old_caps = old > 0 && old < ring->steps;
+    value = (uint16_t)v;
+    caps = value > 0 && value < ring->steps;
+    start_cap = ring->cap(0);
+    end_cap   = ring->cap(value);
+
+    int n = 0;
+    int quarter = -1;
+    for (uint32_t s = lo + 1; s <= hi; s++) {
+      for (uint32_t i = ring->begin[s - 1]; i < ring->begin[s]; i++) {
+        const uint16_t p = ring->order[i];
+        indicator[p] = pixel(p % ring->size, p / ring->size, s);
+      }
+      written += ring->begin[s] - ring->begin[s - 1];
+
+      const int q = (int)((s - 1) * MAX_DIRTY / ring->steps);
+      if (q != quarter) {
+        dirty[n++] = EMPTY;
+        quarter = q;
+      }
+      join(dirty[n - 1], ring->box[s - 1]);
+    }
+
+    // Uiteinden: het oude en het nieuwe bij de waarde, het begin alleen als het
+    // verschijnt of verdwijnt. Elk ligt op grens lo (eerste rechthoek) of op grens
+    // hi (laatste; grens 0 valt daar samen met grens steps).
+    if (old_caps) redraw_cap(ring->cap(old), old == lo ? dirty[0] : dirty[n - 1]);
+    if (caps) redraw_cap(end_cap, value == lo ? dirty[0] : dirty[n - 1]);
+    if (old_caps != caps) redraw_cap(start_cap, lo == 0 ? dirty[0] : dirty[n - 1]);
+    return n;
+  }
+
+private:
+  bool      caps = false;            // ronde uiteinden zichtbaar (0 < value < steps)
+  Ring::Cap start_cap{}, end_cap{};
+
+  uint8_t pixel(int x, int y, uint32_t s) const {
+    uint8_t a = (s && s <= value) ? ring->coverage[y * ring->size + x] : 0;
+    if (caps) {
+      const uint8_t b = ring->cap_coverage(start_cap, x, y), e = ring->cap_coverage(end_cap, x, y);
+      if (b > a) a = b;
+      if (e > a) a = e;
+    }
+    return a;
+  }
+
+  void redraw_cap(const Ring::Cap& k, Rect& dirty) {
+    for (int y = k.box.y1; y <= k.box.y2; y++) {
+      for (int x = k.box.x1; x <= k.box.x2; x++) {
+        const uint32_t p = (uint32_t)y * ring->size + x;
+        if (!ring->coverage[p]) continue;
+        indicator[p] = pixel(x, y, ring->step_of(x, y));
+        written++;
+      }
+    }
+    join(dirty, k.box);
+  }
+};
+
+} // namespace arcgauge
@@ -0,0 +1,65 @@
+// buf_tune.hpp - draw-buffer configuraties doorlopen en de beste kiezen op basis van metingen
+#pragma once
+#include <stdint.h>
+
+namespace buftune {
+
+struct Config {
+  uint16_t lines;     // hoogte van één buffer in lijnen
+  uint8_t  buffers;   // 1 = LVGL wacht op de flush, 2 = render en flush overlappen
+  bool     psram;
+};
+
+struct Result {
+  Config   cfg;
+  bool     ok;          // false: allocatie mislukt, niet gemeten
+  uint32_t frame_us;    // gemiddeld per frame van het update-script, tot de laatste pixel
+  uint32_t flushes;     // gemiddeld per frame
+};
+
+// Lijnhoogtes van de sweep
+constexpr uint16_t LINES[] = { 4, 6, 8, 10, 16, 20, 32, 40, 64, 80 };
+constexpr int LINE_COUNT = sizeof(LINES) / sizeof(LINES[0]);
+constexpr int CONFIG_COUNT = LINE_COUNT * 2 * 2;
+
+inline uint32_t ram_bytes(const Config& c, uint16_t width, uint8_t bytes_per_px = 2) {
+  return (uint32_t)c.lines * width * bytes_per_px * c.buffers;
+}
+
+// Alle combinaties: per geheugen, per aantal buffers, oplopende lijnhoogte
+inline int configs(Config* out) {
+  int n = 0;
+  for (int ps = 0; ps < 2; ps++) {
+    for (uint8_t b = 1; b <= 2; b++) {
+      for (uint16_t lines : LINES) out[n++] = { lines, b, ps != 0 };
+    }
+  }
+  return n;
+}
+
+// Binnen tolerance_pct van de snelste: de minste interne RAM (schaars naast
+// WiFi en de taken), dan de minste RAM in totaal, dan de snelste. -1 als niets gemeten is.
+inline int recommend(const Result* r, int n, uint16_t width, uint32_t tolerance_pct = 5) {
+  int fastest = -1;
+  for (int i = 0; i < n; i++) {
+    if (r[i].ok && (fastest < 0 || r[i].frame_us < r[fastest].frame_us)) fastest = i;
+  }
+  if (fastest < 0) return -1;
+
+  const uint64_t limit = (uint64_t)r[fastest].frame_us * (100 + tolerance_pct) / 100;
+  auto internal = [&](int i) { return r[i].cfg.psram ? 0u : ram_bytes(r[i].cfg, width); };
+
+  int best = fastest;
+  for (int i = 0; i < n; i++) {
+    if (!r[i].ok || r[i].frame_us > limit) continue;
+    if (internal(i) != internal(best)) {
+      if (internal(i) < internal(best)) best = i;
+      continue;
+    }
+    const uint32_t ri = ram_bytes(r[i].cfg, width), rb = ram_bytes(r[best].cfg, width);
+    if (ri < rb || (ri == rb && r[i].frame_us < r[best].frame_us)) best = i;
+  }
+  return best;
+}
+
+}  // namespace buftune
@@ -0,0 +1,146 @@
+// curve_decim.hpp - lange ontladingscurves terugbrengen tot de pixelbreedte van de chart
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+namespace curvedecim {
+
+// ---- Min/max per pixelkolom ----
+// Kolom c dekt de punten [first + c*count/cols, first + (c+1)*count/cols). Per kolom
+// komen min en max eruit in tijdsvolgorde, zodat een lijnchart met 2*cols punten
+// per kolom een verticale streep trekt en pieken nooit wegvallen.
+// Minder punten dan kolommen: de punten zelf, ongewijzigd. Geeft het aantal uitvoerpunten.
+inline uint32_t minmax(const int16_t* y, uint32_t first, uint32_t count,
+                       uint32_t cols, int32_t* out) {
+  if (count <= 2 * cols) {
+    for (uint32_t i = 0; i < count; i++) out[i] = y[first + i];
+    return count;
+  }
+
+  uint32_t n = 0;
+  for (uint32_t c = 0; c < cols; c++) {
+    const uint32_t b = first + (uint32_t)((uint64_t)c * count / cols);
+    const uint32_t e = first + (uint32_t)((uint64_t)(c + 1) * count / cols);
+
+    uint32_t imin = b, imax = b;
+    for (uint32_t i = b + 1; i < e; i++) {
+      if (y[i] < y[imin]) imin = i;
+      if (y[i] > y[imax]) imax = i;
+    }
+    out[n++] = y[(imin <= imax) ? imin : imax];
+    out[n++] = y[(imin <= imax) ? imax : imin];
+  }
+  return n;
+}
+
+// ---- Largest-Triangle-Three-Buckets ----
+// Houdt het eerste en laatste punt en kiest per bucket het punt dat met het vorige
+// gekozen punt en het gemiddelde van de volgende bucket de grootste driehoek maakt.
+// Schrijft de waarden (en optioneel de bronindices). Geeft het aantal uitvoerpunten.
+inline uint32_t lttb(const int16_t* y, uint32_t first, uint32_t count,
+                     uint32_t out_n, int32_t* out, uint32_t* idx = nullptr) {
+  uint32_t n = 0;
+  auto emit = [&](uint32_t i) {
+    out[n] = y[first + i];
+    if (idx) idx[n] = first + i;
+    n++;
+  };
+
+  if (count <= out_n) {
+    for (uint32_t i = 0; i < count; i++) emit(i);
+    return n;
+  }
+  if (out_n < 3) {
+    if (out_n >= 1) emit(0);
+    if (out_n == 2) emit(count - 1);
+    return n;
+  }
+
+  // Buckets over de punten 1 .. count-2; bucket_begin(buckets) == count-1
+  const uint32_t buckets = out_n - 2;
+  auto bucket_begin = [&](uint32_t b) -> uint32_t {
+    return 1 + (uint32_t)((uint64_t)b * (count - 2) / buckets);
+  };
+
+  uint32_t a = 0;   // laatst gekozen punt (relatief aan first)
+  emit(0);
+
+  for (uint32_t b = 0; b < buckets; b++) {
+    const uint32_t lo = bucket_begin(b);
+    const uint32_t hi = bucket_begin(b + 1);
+
+    // Som van de volgende bucket (bij de laatste: alleen het laatste punt)
+    const uint32_t nlo = hi;
+    const uint32_t nhi = (b + 1 < buckets) ? bucket_begin(b + 2) : count;
+    const int64_t  cnt = nhi - nlo;
+    int64_t sum_x = 0, sum_y = 0;
+    for (uint32_t i = nlo; i < nhi; i++) {
+      sum_x += i;
+      sum_y += y[first + i];
+    }
+
+    // 2 * oppervlakte * cnt, met het gemiddelde als (sum_x, sum_y) / cnt: geen float
+    const int64_t ax = a, ay = y[first + a];
+    int64_t  best = -1;
+    uint32_t pick = lo;
+    for (uint32_t i = lo; i < hi; i++) {
+      const int64_t bx = i, by = y[first + i];
+      int64_t area = (ax * cnt - sum_x) * (by - ay) - (ax - bx) * (sum_y - ay * cnt);
+      if (area < 0) area = -area;
+      if (area > best) {
+        best = area;
+        pick = i;
+      }
+    }
+
+    emit(pick);
+    a = pick;
+  }
+
+  emit(count - 1);
+  return n;
+}
+
+// ---- Cache per chart ----
+// Bewaart de gedecimeerde punten (int32_t, direct bruikbaar als externe LVGL-
+// seriebuffer) en rekent alleen opnieuw als de curve, haar revisie of de zoom wijzigt.
+template <uint32_t Cols>
+struct Cache {
+  int32_t  points[2 * Cols] = {};
+  uint32_t n = 0;             // geldige punten in `points`
+  uint32_t first = 0;         // zichtbaar deel van de bron na clampen
+  uint32_t count = 0;
+  uint32_t recomputes = 0;
+
+  // count == 0 betekent de hele curve. true als `points` opnieuw berekend is.
+  bool update(const int16_t* y, uint32_t len, uint32_t rev, uint32_t view_first, uint32_t view_len) {
+    if (!y) len = 0;
+    if (view_first >= len) view_first = 0;
+    if (view_len == 0 || view_len > len - view_first) view_len = len - view_first;
+
+    if (valid_ && y == src_ && len == len_ && rev == rev_ &&
+        view_first == first && view_len == count) {
+      return false;
+    }
+
+    src_  = y;
+    len_  = len;
+    rev_  = rev;
+    first = view_first;
+    count = view_len;
+    valid_ = true;
+    n = (count > 0) ? minmax(y, first, count, Cols, points) : 0;
+    recomputes++;
+    return true;
+  }
+
+  void reset() { valid_ = false; }
+
+private:
+  const int16_t* src_ = nullptr;
+  uint32_t len_ = 0;
+  uint32_t rev_ = 0;
+  bool     valid_ = false;
+};
+
+} // namespace curvedecim
@@ -0,0 +1,113 @@
+// dirty_rects.hpp - geïnvalideerde gebieden samenvoegen tot zo weinig mogelijk flush-rechthoeken
+#pragma once
+#include <stdint.h>
+
+namespace dirtyrect {
+
+// Inclusieve coördinaten, zoals lv_area_t
+struct Rect {
+  int16_t x1, y1, x2, y2;
+};
+
+inline uint32_t area(const Rect& r) {
+  return uint32_t(r.x2 - r.x1 + 1) * uint32_t(r.y2 - r.y1 + 1);
+}
+
+inline Rect join(const Rect& a, const Rect& b) {
+  return { a.x1 < b.x1 ? a.x1 : b.x1, a.y1 < b.y1 ? a.y1 : b.y1,
+           a.x2 > b.x2 ? a.x2 : b.x2, a.y2 > b.y2 ? a.y2 : b.y2 };
+}
+
+inline bool contains(const Rect& outer, const Rect& r) {
+  return r.x1 >= outer.x1 && r.y1 >= outer.y1 && r.x2 <= outer.x2 && r.y2 <= outer.y2;
+}
+
+inline uint32_t overlap(const Rect& a, const Rect& b) {
+  const int x1 = a.x1 > b.x1 ? a.x1 : b.x1, x2 = a.x2 < b.x2 ? a.x2 : b.x2;
+  const int y1 = a.y1 > b.y1 ? a.y1 : b.y1, y2 = a.y2 < b.y2 ? a.y2 : b.y2;
+  return (x1 <= x2 && y1 <= y2) ? uint32_t(x2 - x1 + 1) * uint32_t(y2 - y1 + 1) : 0;
+}
+
+// Meerkost van a en b als één rechthoek versturen, in pixels: de extra pixels van
+// de omhullende min wat een aparte rechthoek kost (adresvenster, DMA-start).
+// Negatief of 0: samenvoegen is goedkoper.
+inline int64_t merge_cost(const Rect& a, const Rect& b, uint32_t setup_px) {
+  const int64_t apart = int64_t(area(a)) + area(b) - overlap(a, b);
+  return int64_t(area(join(a, b))) - apart - setup_px;
+}
+
+// Verzamelt de gebieden van één refresh (max N) en voegt ze daarna gretig samen:
+// steeds het paar met de laagste meerkost, zolang die <= 0 is. Bij N of minder
+// gebieden is dat O(N^3) op een handvol rechthoeken, verwaarloosbaar naast de flush.
+template <int N>
+struct Coalescer {
+  Rect     rects[N];
+  int      count    = 0;
+  uint32_t setup_px = 256;
+
+  void clear() { count = 0; }
+
+  // Gebied dat al gedekt is valt weg. Vol: samen met de rechthoek waar dat het minst kost.
+  void add(const Rect& r) {
+    for (int i = 0; i < count; i++) {
+      if (contains(rects[i], r)) return;
+    }
+    if (count < N) {
+      rects[count++] = r;
+      return;
+    }
+    int best = 0;
+    int64_t best_cost = merge_cost(rects[0], r, setup_px);
+    for (int i = 1; i < count; i++) {
+      const int64_t c = merge_cost(rects[i], r, setup_px);
+      if (c < best_cost) { best = i; best_cost = c; }
+    }
+    rects[best] = join(rects[best], r);
+  }
+
+  // Geeft het aantal rechthoeken; daarna overlappen ze alleen nog waar inkorten
+  // niet in één rechthoek past (die pixels gaan dan twee keer over de bus)
+  int coalesce() {
+    while (count > 1) {
+      int bi = -1, bj = -1;
+      int64_t best = 1;
+      for (int i = 0; i < count; i++) {
+        for (int j = i + 1; j < count; j++) {
+          const int64_t c = merge_cost(rects[i], rects[j], setup_px);
+          if (c < best) { best = c; bi = i; bj = j; }
+        }
+      }
+      if (best > 0) break;
+      rects[bi] = join(rects[bi], rects[bj]);
+      rects[bj] = rects[--count];
+    }
+
+    for (int i = 0; i < count; i++) {
+      for (int j = 0; j < count; j++) {
+        if (i != j) trim(rects[j], rects[i]);
+      }
+    }
+    return count;
+  }
+
+  uint32_t pixels() const {
+    uint32_t n = 0;
+    for (int i = 0; i < count; i++) n += area(rects[i]);
+    return n;
+  }
+
+private:
+  // r inkorten tot buiten `keep`, als wat overblijft nog één rechthoek is
+  static void trim(Rect& r, const Rect& keep) {
+    if (!overlap(r, keep)) return;
+    if (keep.x1 <= r.x1 && keep.x2 >= r.x2) {          // keep dekt de volle breedte
+      if (keep.y1 <= r.y1 && keep.y2 < r.y2) r.y1 = keep.y2 + 1;
+      else if (keep.y2 >= r.y2 && keep.y1 > r.y1) r.y2 = keep.y1 - 1;
+    } else if (keep.y1 <= r.y1 && keep.y2 >= r.y2) {   // keep dekt de volle hoogte
+      if (keep.x1 <= r.x1 && keep.x2 < r.x2) r.x1 = keep.x2 + 1;
+      else if (keep.x2 >= r.x2 && keep.x1 > r.x1) r.x2 = keep.x1 - 1;
+    }
+  }
+};
+
+}  // namespace dirtyrect
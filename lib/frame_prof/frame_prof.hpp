@@ -0,0 +1,180 @@
+// frame_prof.hpp - per-frame render/flush profiler: records, lock-free ring, binair formaat
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+namespace frameprof {
+
+// Eén LVGL-refresh, gemeten in de display-taak en de flush-taak
+struct FrameRecord {
+  uint32_t seq;          // frame-nummer (gaten = verloren records)
+  uint32_t t_ms;         // begin van de refresh, ms sinds boot
+  uint16_t inv_areas;    // lv_inv_area-aanroepen sinds de vorige refresh
+  uint16_t flushes;      // flush-callbacks (stripes)
+  uint32_t px_rendered;  // pixels die LVGL in de drawbuffers rendert (som flush-gebieden)
+  uint32_t px_pushed;    // pixels die de driver echt naar het paneel stuurt
+  uint32_t timer_us;     // hele lv_timer_handler()
+  uint32_t render_us;    // REFR_START..REFR_READY min wachten op een vrij buffer
+  uint32_t flush_us;     // som van de transfers (ili9488_push_pixels)
+  uint32_t wait_us;      // LVGL wachtend op de flush-taak
+};
+
+// ---- Lock-free ring (één producer, één consumer) ----
+// Producer: display-taak aan het eind van een frame. Consumer: telemetrie-taak
+// die naar serial schrijft. Vol = nieuw record weggooien en tellen, nooit blokkeren.
+template <class T, size_t N>
+class SpscRing {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "N moet een macht van 2 zijn");
+
+public:
+  bool push(const T& v) {
+    const uint32_t h = head_.load(std::memory_order_relaxed);
+    if (h - tail_.load(std::memory_order_acquire) == N) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    buf_[h & (N - 1)] = v;
+    head_.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(T& out) {
+    const uint32_t t = tail_.load(std::memory_order_relaxed);
+    if (t == head_.load(std::memory_order_acquire)) return false;
+    out = buf_[t & (N - 1)];
+    tail_.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  size_t size() const { return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire); }
+  uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+  T buf_[N];
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+  std::atomic<uint32_t> dropped_{0};
+};
+
+// ---- Binair formaat ----
+// [0xF5 0x5F] [type] [payload, little endian] [crc8 over type + payload]
+// Sync + CRC zodat de decoder tussen gewone Serial.printf-tekst door kan lezen.
+constexpr uint8_t SYNC0 = 0xF5;
+constexpr uint8_t SYNC1 = 0x5F;
+constexpr uint8_t TYPE_FRAME = 0x01;
+
+constexpr size_t PAYLOAD_BYTES = 4 + 4 + 2 + 2 + 4 * 6;
+constexpr size_t RECORD_BYTES  = 2 + 1 + PAYLOAD_BYTES + 1;
+
+// CRC-8, polynoom 0x07
+inline uint8_t crc8(const uint8_t* p, size_t n, uint8_t crc = 0) {
+  for (size_t i = 0; i < n; i++) {
+    crc ^= p[i];
+    for (int k = 0; k < 8; k++) crc = (crc & 0x80) ? uint8_t((crc << 1) ^ 0x07) : uint8_t(crc << 1);
+  }
+  return crc;
+}
+
+inline uint8_t* put16(uint8_t* p, uint16_t v) { p[0] = v; p[1] = v >> 8; return p + 2; }
+inline uint8_t* put32(uint8_t* p, uint32_t v) { p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24; return p + 4; }
+inline uint16_t get16(const uint8_t* p) { return uint16_t(p[0] | (p[1] << 8)); }
+inline uint32_t get32(const uint8_t* p) { return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24); }
+
+// Schrijft precies RECORD_BYTES bytes
+inline size_t encode(const FrameRecord& r, uint8_t* out) {
+  uint8_t* p = out;
+  *p++ = SYNC0;
+  *p++ = SYNC1;
+  *p++ = TYPE_FRAME;
+  p = put32(p, r.seq);
+  p = put32(p, r.t_ms);
+  p = put16(p, r.inv_areas);
+  p = put16(p, r.flushes);
+  p = put32(p, r.px_rendered);
+  p = put32(p, r.px_pushed);
+  p = put32(p, r.timer_us);
+  p = put32(p, r.render_us);
+  p = put32(p, r.flush_us);
+  p = put32(p, r.wait_us);
+  *p = crc8(out + 2, 1 + PAYLOAD_BYTES);
+  return RECORD_BYTES;
+}
+
+inline FrameRecord decode_payload(const uint8_t* p) {
+  FrameRecord r;
+  r.seq         = get32(p);      p += 4;
+  r.t_ms        = get32(p);      p += 4;
+  r.inv_areas   = get16(p);      p += 2;
+  r.flushes     = get16(p);      p += 2;
+  r.px_rendered = get32(p);      p += 4;
+  r.px_pushed   = get32(p);      p += 4;
+  r.timer_us    = get32(p);      p += 4;
+  r.render_us   = get32(p);      p += 4;
+  r.flush_us    = get32(p);      p += 4;
+  r.wait_us     = get32(p);
+  return r;
+}
+
+// Streaming decoder: byte voor byte voeden, geeft true als er een record klaar is.
+// Foute CRC of onbekend type: tellen en in de al ontvangen bytes opnieuw naar een
+// sync-paar zoeken, zodat een afgekapt record het volgende niet meeneemt.
+class Decoder {
+public:
+  bool feed(uint8_t b, FrameRecord& out) {
+    switch (state_) {
+      case 0:
+        if (b == SYNC0) state_ = 1;
+        else skipped_++;
+        return false;
+      case 1:
+        if (b == SYNC1) { state_ = 2; n_ = 0; }
+        else if (b != SYNC0) { state_ = 0; skipped_ += 2; }
+        else skipped_++;
+        return false;
+      default:
+        buf_[n_++] = b;
+        if (n_ == 1 && b != TYPE_FRAME) { bad_++; resync(); return false; }
+        if (n_ < 1 + PAYLOAD_BYTES + 1) return false;
+        if (crc8(buf_, 1 + PAYLOAD_BYTES) != buf_[1 + PAYLOAD_BYTES]) {
+          bad_++;
+          resync();
+          return false;
+        }
+        state_ = 0;
+        out = decode_payload(buf_ + 1);
+        return true;
+    }
+  }
+
+  uint32_t skipped() const { return skipped_; }   // bytes buiten records (tekst e.d.)
+  uint32_t bad() const { return bad_; }           // records met foute CRC of type
+
+private:
+  // Eerste sync-paar in buf_[0..n_) zoeken; wat erachter staat wordt het begin van
+  // een nieuw record. Een losse SYNC0 aan het eind wacht op de volgende byte.
+  void resync() {
+    size_t i = 0;
+    for (;;) {
+      while (i < n_ && buf_[i] != SYNC0) i++;
+      if (i >= n_) { state_ = 0; return; }
+      if (i + 1 == n_) { state_ = 1; return; }
+      if (buf_[i + 1] != SYNC1) { i++; continue; }
+      size_t rest = n_ - (i + 2);
+      for (size_t k = 0; k < rest; k++) buf_[k] = buf_[i + 2 + k];
+      n_ = rest;
+      state_ = 2;
+      if (n_ == 0 || buf_[0] == TYPE_FRAME) return;
+      bad_++;
+      i = 0;
+    }
+  }
+
+  uint8_t  buf_[1 + PAYLOAD_BYTES + 1];
+  size_t   n_ = 0;
+  int      state_ = 0;
+  uint32_t skipped_ = 0;
+  uint32_t bad_ = 0;
+};
+
+} // namespace frameprof
@@ -0,0 +1,81 @@
+// frame_prof_stats.hpp - host-side samenvattingen van FrameRecords (percentielen, flame-stacks)
+#pragma once
+#include <stdint.h>
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "frame_prof.hpp"
+
+namespace frameprof {
+
+// Nearest-rank percentiel (p in 0..100); lege lijst = 0
+inline uint32_t percentile(std::vector<uint32_t> v, double p) {
+  if (v.empty()) return 0;
+  std::sort(v.begin(), v.end());
+  size_t rank = static_cast<size_t>(p / 100.0 * v.size() + 0.999999);
+  if (rank < 1) rank = 1;
+  if (rank > v.size()) rank = v.size();
+  return v[rank - 1];
+}
+
+struct Metric {
+  const char* name;
+  uint32_t FrameRecord::*field;
+};
+
+inline const std::vector<Metric>& metrics() {
+  static const std::vector<Metric> m = {
+    { "timer_us",    &FrameRecord::timer_us },
+    { "render_us",   &FrameRecord::render_us },
+    { "flush_us",    &FrameRecord::flush_us },
+    { "wait_us",     &FrameRecord::wait_us },
+    { "px_rendered", &FrameRecord::px_rendered },
+    { "px_pushed",   &FrameRecord::px_pushed },
+  };
+  return m;
+}
+
+struct Summary {
+  size_t   frames = 0;
+  uint32_t lost   = 0;   // gaten in seq
+  uint64_t inv_areas = 0, flushes = 0;
+  uint64_t timer_us = 0, render_us = 0, flush_us = 0, wait_us = 0;
+};
+
+inline Summary summarize(const std::vector<FrameRecord>& recs) {
+  Summary s;
+  s.frames = recs.size();
+  for (size_t i = 0; i < recs.size(); i++) {
+    const FrameRecord& r = recs[i];
+    if (i && r.seq > recs[i - 1].seq + 1) s.lost += r.seq - recs[i - 1].seq - 1;
+    s.inv_areas += r.inv_areas;
+    s.flushes   += r.flushes;
+    s.timer_us  += r.timer_us;
+    s.render_us += r.render_us;
+    s.flush_us  += r.flush_us;
+    s.wait_us   += r.wait_us;
+  }
+  return s;
+}
+
+// Folded stacks (flamegraph.pl / speedscope): waar gaat lv_timer_handler-tijd heen.
+// Render en wachten zitten in de timer-handler; de rest is overige timers/overhead.
+// Flush loopt async in een eigen taak en krijgt een eigen stack.
+inline std::vector<std::string> folded_stacks(const Summary& s) {
+  const uint64_t inside = s.render_us + s.wait_us;
+  const uint64_t other  = (s.timer_us > inside) ? s.timer_us - inside : 0;
+  auto line = [](const char* stack, uint64_t us) {
+    char buf[128];
+    std::snprintf(buf, sizeof(buf), "%s %llu", stack, (unsigned long long)us);
+    return std::string(buf);
+  };
+  return {
+    line("display_task;lv_timer_handler;render", s.render_us),
+    line("display_task;lv_timer_handler;wait_flush", s.wait_us),
+    line("display_task;lv_timer_handler;other", other),
+    line("flush_task;ili9488_push_pixels", s.flush_us),
+  };
+}
+
+} // namespace frameprof
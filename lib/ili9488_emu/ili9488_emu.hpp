@@ -0,0 +1,389 @@
+// ili9488_emu.hpp - host-side emulator van de ILI9488-controller (alleen Linux/tests)
+//
+// Decodeert de bytes die include/ili9488_driver.hpp op de bus zet (RS + D0..D7)
+// naar een 320x480 RGB565-framebuffer, en houdt bij hoeveel WR-cycli dat kostte
+// zodat de busduur bij een gegeven WR-klok geschat kan worden.
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace emu {
+
+// Commando's die de driver gebruikt
+enum : uint8_t {
+  CMD_SWRESET = 0x01,
+  CMD_SLPOUT  = 0x11,
+  CMD_NORON   = 0x13,
+  CMD_INVOFF  = 0x20,
+  CMD_INVON   = 0x21,
+  CMD_DISPOFF = 0x28,
+  CMD_DISPON  = 0x29,
+  CMD_CASET   = 0x2A,
+  CMD_PASET   = 0x2B,
+  CMD_RAMWR   = 0x2C,
+  CMD_VSCRDEF = 0x33,
+  CMD_MADCTL  = 0x36,
+  CMD_VSCRSADD = 0x37,
+  CMD_COLMOD  = 0x3A,
+  CMD_RAMWRC  = 0x3C,
+};
+
+// MADCTL bits
+enum : uint8_t {
+  MADCTL_MY  = 0x80,
+  MADCTL_MX  = 0x40,
+  MADCTL_MV  = 0x20,
+  MADCTL_BGR = 0x08,
+};
+
+struct EmuStats {
+  uint64_t wr_cycles = 0;   // elke byte = één WR-puls
+  uint32_t commands  = 0;
+  uint32_t windows   = 0;   // CASET/PASET-paren
+  uint64_t pixels    = 0;
+  uint32_t unknown   = 0;   // commando's die de emulator niet kent
+};
+
+class Ili9488Emu {
+public:
+  static constexpr int WIDTH  = 320;   // fysiek geheugen: 320 kolommen
+  static constexpr int HEIGHT = 480;   //                  480 rijen
+
+  // wr_hz: WR-klok waarmee de bus draait (bit-bang of i80)
+  // panel_inverted: dit glas toont kleuren geïnverteerd bij INVOFF (zie driver)
+  // panel_bgr: subpixels van het glas staan in BGR-volgorde (MADCTL.BGR = 1 is "goed")
+  explicit Ili9488Emu(uint32_t wr_hz = 10000000, bool panel_inverted = true, bool panel_bgr = true)
+    : wr_hz_(wr_hz), panel_inverted_(panel_inverted), panel_bgr_(panel_bgr), fb_(WIDTH * HEIGHT, 0) {
+    hw_reset();
+  }
+
+  // ---- busingang ----
+  void write(bool rs, uint8_t v) {
+    stats_.wr_cycles++;
+    if (!rs) command(v);
+    else     data(v);
+  }
+
+  // Alles met .rs en .data (bv. lcdbus::BusCycle uit de nep-registers)
+  template <class Range>
+  void feed(const Range& cycles) {
+    for (const auto& c : cycles) write(c.rs, c.data);
+  }
+
+  void command(uint8_t cmd) {
+    cmd_ = cmd;
+    nparam_ = 0;
+    stats_.commands++;
+
+    switch (cmd) {
+      case CMD_SWRESET: sw_reset(); break;
+      case CMD_SLPOUT:  sleeping_ = false; break;
+      case CMD_INVOFF:  invon_ = false; break;
+      case CMD_INVON:   invon_ = true; break;
+      case CMD_DISPOFF: display_on_ = false; break;
+      case CMD_DISPON:  display_on_ = true; break;
+      case CMD_RAMWR:   col_ = xs_; page_ = ys_; partial_ = 0; pbytes_ = 0; break;
+      case CMD_RAMWRC:  partial_ = 0; pbytes_ = 0; break;
+      case CMD_NORON:   scrolling_ = false; break;
+      case CMD_CASET:
+      case CMD_VSCRDEF:
+      case CMD_VSCRSADD:
+      case CMD_PASET:
+      case CMD_MADCTL:
+      case CMD_COLMOD:
+        break;
+      default:
+        stats_.unknown++;
+        break;
+    }
+  }
+
+  void data(uint8_t v) {
+    switch (cmd_) {
+      case CMD_CASET:
+        set_range_byte(v, xs_, xe_);
+        if (nparam_ == 4) { col_ = xs_; stats_.windows++; }
+        break;
+      case CMD_PASET:
+        set_range_byte(v, ys_, ye_);
+        if (nparam_ == 4) page_ = ys_;
+        break;
+      case CMD_MADCTL: madctl_ = v; nparam_++; break;
+      case CMD_COLMOD: colmod_ = v; nparam_++; break;
+      case CMD_VSCRDEF:
+        // TFA, VSA, BFA: elk 2 bytes big endian
+        if (nparam_ < 6) {
+          uint16_t& r = scroll_def_[nparam_ / 2];
+          r = (nparam_ % 2 == 0) ? static_cast<uint16_t>(v << 8) : static_cast<uint16_t>(r | v);
+        }
+        nparam_++;
+        break;
+      case CMD_VSCRSADD:
+        if (nparam_ == 0) vsp_ = static_cast<uint16_t>(v << 8);
+        if (nparam_ == 1) { vsp_ |= v; scrolling_ = true; }
+        nparam_++;
+        break;
+      case CMD_RAMWR:
+      case CMD_RAMWRC:
+        pixel_byte(v);
+        break;
+      default:
+        break;
+    }
+  }
+
+  // ---- toestand ----
+  uint8_t  madctl() const     { return madctl_; }
+  uint8_t  colmod() const     { return colmod_; }
+  bool     inverted() const   { return invon_; }
+  bool     sleeping() const   { return sleeping_; }
+  bool     display_on() const { return display_on_; }
+
+  // Vertical scroll: TFA/VSA/BFA in geheugenrijen, VSP = eerste rij van het scrollgebied
+  bool     scrolling() const  { return scrolling_; }
+  uint16_t scroll_tfa() const { return scroll_def_[0]; }
+  uint16_t scroll_vsa() const { return scroll_def_[1]; }
+  uint16_t scroll_bfa() const { return scroll_def_[2]; }
+  uint16_t scroll_vsp() const { return vsp_; }
+
+  // Welke geheugenrij gate-lijn (fysieke rij) y laat zien
+  int scanout_row(int y) const {
+    const int tfa = scroll_def_[0], vsa = scroll_def_[1];
+    if (!scrolling_ || vsa == 0 || y < tfa || y >= tfa + vsa) return y;
+    return tfa + ((y - tfa) + (vsp_ - tfa) % vsa + vsa) % vsa;
+  }
+
+  // Logische afmetingen in de huidige oriëntatie (MV verwisselt ze)
+  int logical_width() const  { return (madctl_ & MADCTL_MV) ? HEIGHT : WIDTH; }
+  int logical_height() const { return (madctl_ & MADCTL_MV) ? WIDTH : HEIGHT; }
+
+  // Ruwe RGB565 zoals geschreven, in fysieke geheugenvolgorde
+  uint16_t raw(int x, int y) const { return fb_[y * WIDTH + x]; }
+  const std::vector<uint16_t>& framebuffer() const { return fb_; }
+
+  // Kolom/pagina zoals de driver ze adresseert -> fysiek adres
+  void map_address(int col, int page, int& x, int& y) const {
+    x = col;
+    y = page;
+    if (madctl_ & MADCTL_MV) { int t = x; x = y; y = t; }
+    if (madctl_ & MADCTL_MX) x = WIDTH - 1 - x;
+    if (madctl_ & MADCTL_MY) y = HEIGHT - 1 - y;
+  }
+
+  // Wat je op het glas ziet, als RGB565 in normale R-G-B volgorde
+  // (inclusief vertical scroll: gate-lijn y toont geheugenrij scanout_row(y))
+  uint16_t visible(int x, int y) const {
+    uint16_t c = raw(x, scanout_row(y));
+    if (invon_ != panel_inverted_) c = static_cast<uint16_t>(~c);
+    if (((madctl_ & MADCTL_BGR) != 0) != panel_bgr_) {
+      c = static_cast<uint16_t>(((c & 0x001F) << 11) | (c & 0x07E0) | ((c & 0xF800) >> 11));
+    }
+    return c;
+  }
+
+  // Zichtbare pixel op logische positie in de huidige oriëntatie
+  uint16_t visible_logical(int col, int page) const {
+    int x, y;
+    map_address(col, page, x, y);
+    return visible(x, y);
+  }
+
+  // ---- timing ----
+  const EmuStats& stats() const { return stats_; }
+  void reset_stats() { stats_ = EmuStats{}; }
+  uint32_t wr_hz() const { return wr_hz_; }
+  void set_wr_hz(uint32_t hz) { wr_hz_ = hz; }
+
+  // Geschatte busduur van alles sinds reset_stats() bij de ingestelde WR-klok
+  double bus_us() const { return static_cast<double>(stats_.wr_cycles) * 1e6 / wr_hz_; }
+
+  // ---- dumps ----
+  // logical = true: beeld zoals de UI het ziet (huidige MADCTL), anders fysiek 320x480
+  bool write_ppm(const std::string& path, bool logical = true) const {
+    int w, h;
+    std::vector<uint8_t> rgb = to_rgb888(logical, w, h);
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    std::fprintf(f, "P6\n%d %d\n255\n", w, h);
+    std::fwrite(rgb.data(), 1, rgb.size(), f);
+    std::fclose(f);
+    return true;
+  }
+
+  bool write_png(const std::string& path, bool logical = true) const {
+    int w, h;
+    std::vector<uint8_t> rgb = to_rgb888(logical, w, h);
+    std::vector<uint8_t> png = encode_png(rgb, w, h);
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    std::fwrite(png.data(), 1, png.size(), f);
+    std::fclose(f);
+    return true;
+  }
+
+  std::vector<uint8_t> to_rgb888(bool logical, int& w, int& h) const {
+    w = logical ? logical_width() : WIDTH;
+    h = logical ? logical_height() : HEIGHT;
+    std::vector<uint8_t> out(static_cast<size_t>(w) * h * 3);
+    for (int y = 0; y < h; y++) {
+      for (int x = 0; x < w; x++) {
+        const uint16_t c = logical ? visible_logical(x, y) : visible(x, y);
+        uint8_t* p = &out[(static_cast<size_t>(y) * w + x) * 3];
+        p[0] = static_cast<uint8_t>(((c >> 11) & 0x1F) * 255 / 31);
+        p[1] = static_cast<uint8_t>(((c >> 5) & 0x3F) * 255 / 63);
+        p[2] = static_cast<uint8_t>((c & 0x1F) * 255 / 31);
+      }
+    }
+    return out;
+  }
+
+  // Ongecomprimeerde PNG (deflate "stored" blocks): geen zlib nodig
+  static std::vector<uint8_t> encode_png(const std::vector<uint8_t>& rgb, int w, int h) {
+    std::vector<uint8_t> raw;
+    raw.reserve(static_cast<size_t>(h) * (w * 3 + 1));
+    for (int y = 0; y < h; y++) {
+      raw.push_back(0);   // filter: none
+      raw.insert(raw.end(), rgb.begin() + static_cast<size_t>(y) * w * 3,
+                 rgb.begin() + static_cast<size_t>(y + 1) * w * 3);
+    }
+
+    std::vector<uint8_t> z = {0x78, 0x01};
+    size_t off = 0;
+    do {
+      const size_t n = (raw.size() - off > 65535) ? 65535 : raw.size() - off;
+      z.push_back(off + n == raw.size() ? 1 : 0);   // BFINAL, BTYPE = stored
+      z.push_back(n & 0xFF);
+      z.push_back(n >> 8);
+      z.push_back(~n & 0xFF);
+      z.push_back((~n >> 8) & 0xFF);
+      z.insert(z.end(), raw.begin() + off, raw.begin() + off + n);
+      off += n;
+    } while (off < raw.size());
+    put_be32(z, adler32(raw));
+
+    std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    std::vector<uint8_t> ihdr;
+    put_be32(ihdr, w);
+    put_be32(ihdr, h);
+    ihdr.insert(ihdr.end(), {8, 2, 0, 0, 0});   // 8 bit, RGB
+    put_chunk(png, "IHDR", ihdr);
+    put_chunk(png, "IDAT", z);
+    put_chunk(png, "IEND", {});
+    return png;
+  }
+
+private:
+  void hw_reset() {
+    madctl_     = 0;
+    colmod_     = 0x66;   // na reset 18 bpp
+    invon_      = false;
+    sleeping_   = true;
+    display_on_ = false;
+    xs_ = 0; xe_ = WIDTH - 1;
+    ys_ = 0; ye_ = HEIGHT - 1;
+    col_ = 0; page_ = 0;
+    cmd_ = 0; nparam_ = 0;
+    partial_ = 0; pbytes_ = 0;
+    scroll_def_[0] = 0; scroll_def_[1] = HEIGHT; scroll_def_[2] = 0;
+    vsp_ = 0;
+    scrolling_ = false;
+  }
+
+  void sw_reset() {
+    // Framebuffer-inhoud blijft staan, registers terug naar default
+    hw_reset();
+  }
+
+  // CASET/PASET: 4 bytes = start hi/lo, eind hi/lo
+  void set_range_byte(uint8_t v, uint16_t& start, uint16_t& end) {
+    switch (nparam_) {
+      case 0: start = static_cast<uint16_t>(v << 8); break;
+      case 1: start |= v; break;
+      case 2: end = static_cast<uint16_t>(v << 8); break;
+      case 3: end |= v; break;
+      default: return;
+    }
+    nparam_++;
+  }
+
+  void pixel_byte(uint8_t v) {
+    const bool bpp16 = (colmod_ & 0x07) == 0x05;
+    partial_ = (partial_ << 8) | v;
+    pbytes_++;
+
+    if (bpp16 && pbytes_ == 2) {
+      store(static_cast<uint16_t>(partial_));
+    } else if (!bpp16 && pbytes_ == 3) {
+      // RGB666: elke byte bevat 6 bits in de bovenste bits
+      const uint8_t r = (partial_ >> 16) & 0xFF, g = (partial_ >> 8) & 0xFF, b = partial_ & 0xFF;
+      store(static_cast<uint16_t>(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)));
+    } else {
+      return;
+    }
+    partial_ = 0;
+    pbytes_ = 0;
+  }
+
+  void store(uint16_t c) {
+    int x, y;
+    map_address(col_, page_, x, y);
+    if (x >= 0 && x < WIDTH && y >= 0 && y < HEIGHT) fb_[y * WIDTH + x] = c;
+    stats_.pixels++;
+
+    // Schrijfpointer: kolom eerst, dan pagina, wrap binnen het window
+    if (col_ >= xe_) {
+      col_ = xs_;
+      page_ = (page_ >= ye_) ? ys_ : page_ + 1;
+    } else {
+      col_++;
+    }
+  }
+
+  static uint32_t adler32(const std::vector<uint8_t>& d) {
+    uint32_t a = 1, b = 0;
+    for (uint8_t v : d) { a = (a + v) % 65521; b = (b + a) % 65521; }
+    return (b << 16) | a;
+  }
+
+  static uint32_t crc32(const uint8_t* p, size_t n, uint32_t crc = 0xFFFFFFFFu) {
+    for (size_t i = 0; i < n; i++) {
+      crc ^= p[i];
+      for (int k = 0; k < 8; k++) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+    }
+    return crc;
+  }
+
+  static void put_be32(std::vector<uint8_t>& o, uint32_t v) {
+    o.push_back(v >> 24); o.push_back(v >> 16); o.push_back(v >> 8); o.push_back(v);
+  }
+
+  static void put_chunk(std::vector<uint8_t>& o, const char* type, const std::vector<uint8_t>& d) {
+    put_be32(o, static_cast<uint32_t>(d.size()));
+    const size_t start = o.size();
+    o.insert(o.end(), type, type + 4);
+    o.insert(o.end(), d.begin(), d.end());
+    put_be32(o, ~crc32(&o[start], o.size() - start));
+  }
+
+  uint32_t wr_hz_;
+  bool     panel_inverted_;
+  bool     panel_bgr_;
+  std::vector<uint16_t> fb_;
+  EmuStats stats_;
+
+  uint8_t  madctl_, colmod_;
+  bool     invon_, sleeping_, display_on_;
+  uint16_t scroll_def_[3];   // TFA, VSA, BFA
+  uint16_t vsp_;
+  bool     scrolling_;
+  uint16_t xs_, xe_, ys_, ye_;
+  uint16_t col_, page_;
+  uint8_t  cmd_, nparam_;
+  uint32_t partial_;
+  uint8_t  pbytes_;
+};
+
+} // namespace emu
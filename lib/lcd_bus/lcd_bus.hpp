@@ -0,0 +1,78 @@
+// lcd_bus.hpp - 8-bit parallelle (i80) buswriter via directe GPIO set/clear registers
+#pragma once
+#include <stdint.h>
+
+#if defined(ESP_PLATFORM)
+#include <soc/gpio_struct.h>
+#endif
+
+namespace lcdbus {
+
+// GPIO0..31 zitten in bank 0 (out_w1ts/out_w1tc), GPIO32..53 in bank 1 (out1_*)
+constexpr int      bank_of(int pin) { return (pin >= 32) ? 1 : 0; }
+constexpr uint32_t mask_of(int pin) { return (pin < 0) ? 0u : (1u << (pin & 31)); }
+
+#if defined(ESP_PLATFORM)
+// Echte registers: elke set/clr is precies één 32-bit store
+struct Esp32GpioRegs {
+  template <int Bank> static inline void set(uint32_t m) {
+    if constexpr (Bank == 0) GPIO.out_w1ts = m;
+    else                     GPIO.out1_w1ts.val = m;
+  }
+  template <int Bank> static inline void clr(uint32_t m) {
+    if constexpr (Bank == 0) GPIO.out_w1tc = m;
+    else                     GPIO.out1_w1tc.val = m;
+  }
+};
+#endif
+
+// Pins:  struct met static constexpr int D0, WR, RS, CS  (CS = -1 als hij vast laag zit)
+// Regs:  Esp32GpioRegs op target, FakeGpioRegs<Pins> op de host
+//
+// D0..D7 moeten aaneengesloten in bank 0 liggen, dan is de mapping byte -> register
+// gewoon een shift die de compiler volledig wegvouwt.
+template <class Pins, class Regs>
+struct ParallelBus8 {
+  static_assert(Pins::D0 >= 0 && Pins::D0 + 7 < 32, "D0..D7 moeten aaneengesloten in GPIO bank 0 liggen");
+  static_assert(Pins::WR >= 0 && Pins::WR < 32, "WR moet in GPIO bank 0 liggen");
+  static_assert(Pins::WR < Pins::D0 || Pins::WR > Pins::D0 + 7, "WR mag niet op de databus liggen");
+  static_assert(Pins::RS >= 0, "RS is verplicht");
+
+  static constexpr uint32_t DATA_MASK = 0xFFu << Pins::D0;
+  static constexpr uint32_t WR_MASK   = mask_of(Pins::WR);
+
+  // Eén buscyclus = 3 stores:
+  //   1) data-bits + WR laag,  2) data-bits die 1 moeten zijn hoog,
+  //   3) WR hoog (paneel latcht op de stijgende flank, data staat dan al stabiel)
+  static inline void write(uint8_t v) {
+    Regs::template clr<0>(DATA_MASK | WR_MASK);
+    Regs::template set<0>(static_cast<uint32_t>(v) << Pins::D0);
+    Regs::template set<0>(WR_MASK);
+  }
+
+  // Alleen WR togglen: herhaalt de byte die nog op de bus staat
+  static inline void strobe() {
+    Regs::template clr<0>(WR_MASK);
+    Regs::template set<0>(WR_MASK);
+  }
+
+  static inline void rs_command() { Regs::template clr<bank_of(Pins::RS)>(mask_of(Pins::RS)); }
+  static inline void rs_data()    { Regs::template set<bank_of(Pins::RS)>(mask_of(Pins::RS)); }
+
+  static inline void cs_low() {
+    if constexpr (Pins::CS >= 0) Regs::template clr<bank_of(Pins::CS)>(mask_of(Pins::CS));
+  }
+  static inline void cs_high() {
+    if constexpr (Pins::CS >= 0) Regs::template set<bank_of(Pins::CS)>(mask_of(Pins::CS));
+  }
+
+  // Idle-toestand: CS hoog, RS data, WR hoog, databus laag
+  static inline void idle() {
+    cs_high();
+    rs_data();
+    Regs::template clr<0>(DATA_MASK);
+    Regs::template set<0>(WR_MASK);
+  }
+};
+
+} // namespace lcdbus
@@ -0,0 +1,78 @@
+// lcd_bus_fake.hpp - host-side nep-registerbestand voor ParallelBus8 (alleen voor Linux/tests)
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include "lcd_bus.hpp"
+
+namespace lcdbus {
+
+// Eén gelatchte buscyclus zoals het paneel hem ziet
+struct BusCycle {
+  uint8_t data;
+  bool    rs;     // true = data, false = command
+};
+
+// Houdt out/out1 bij zoals de echte GPIO-bank en latcht de databyte op elke
+// stijgende WR-flank terwijl CS laag is (of CS niet bestaat).
+template <class Pins>
+struct FakeGpioRegs {
+  struct State {
+    uint32_t out[2] = {0, 0};
+    uint32_t stores = 0;
+    uint32_t cs_toggles = 0;   // transactieteller: elke flank van CS
+    uint32_t rs_toggles = 0;   // elke wissel command <-> data
+    std::vector<BusCycle> cycles;
+  };
+
+  static State& state() {
+    static State s;
+    return s;
+  }
+
+  // Na reset staat de bus in rust: CS, RS en WR hoog, databus laag
+  static void reset() {
+    State& s = state();
+    s = State{};
+    s.out[bank_of(Pins::WR)] |= mask_of(Pins::WR);
+    s.out[bank_of(Pins::RS)] |= mask_of(Pins::RS);
+    s.out[bank_of(Pins::CS)] |= mask_of(Pins::CS);
+  }
+
+  template <int Bank> static void set(uint32_t m) { apply(Bank, state().out[Bank] | m); }
+  template <int Bank> static void clr(uint32_t m) { apply(Bank, state().out[Bank] & ~m); }
+
+  static bool level(int pin) {
+    return (state().out[bank_of(pin)] & mask_of(pin)) != 0;
+  }
+
+  // Alleen de databytes, in volgorde
+  static std::vector<uint8_t> bytes() {
+    std::vector<uint8_t> out;
+    out.reserve(state().cycles.size());
+    for (const auto& c : state().cycles) out.push_back(c.data);
+    return out;
+  }
+
+private:
+  static void apply(int bank, uint32_t next) {
+    State& s = state();
+    s.stores++;
+
+    const bool wr_before = level(Pins::WR);
+    const bool cs_before = level(Pins::CS);
+    const bool rs_before = level(Pins::RS);
+    s.out[bank] = next;
+    const bool wr_after = level(Pins::WR);
+
+    if (Pins::CS >= 0 && level(Pins::CS) != cs_before) s.cs_toggles++;
+    if (level(Pins::RS) != rs_before) s.rs_toggles++;
+
+    const bool selected = (Pins::CS < 0) || !level(Pins::CS);
+    if (!wr_before && wr_after && selected) {
+      const uint8_t data = static_cast<uint8_t>(s.out[0] >> Pins::D0);
+      s.cycles.push_back({data, level(Pins::RS)});
+    }
+  }
+};
+
+} // namespace lcdbus
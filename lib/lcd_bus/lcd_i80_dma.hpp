@@ -0,0 +1,191 @@
+// lcd_i80_dma.hpp - i80 (LCD_CAM) + GDMA engines voor de ILI9488 transport-laag
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+#if defined(ESP_PLATFORM)
+#include <esp_idf_version.h>
+#include <esp_lcd_panel_io.h>
+#include <esp_heap_caps.h>
+#include <esp_err.h>
+#include <esp_attr.h>
+#else
+#include <vector>
+#endif
+
+namespace lcdbus {
+
+// Eén GDMA-descriptor kan max 4095 bytes dragen; 4092 houdt elke descriptor word-aligned
+constexpr size_t DMA_DESC_MAX = 4092;
+
+// Engine-interface (alles static):
+//   init(max_transfer)            bus + panel-IO aanmaken (tweede keer: no-op)
+//   deinit()                      bus vrijgeven, bv. voor een andere LCD_CAM-gebruiker
+//   alloc(bytes)                  DMA-capabel geheugen voor staging-buffers (nullptr: op)
+//   tx_param(cmd, p, n)           commando + parameters, blokkerend
+//   tx_color(cmd, buf, n)         commando + pixeldata via DMA, asynchroon
+//   wait_pending(n)               wacht tot er hooguit n tx_color's onderweg zijn
+
+#if defined(ESP_PLATFORM)
+// Target: IDF esp_lcd i80-driver. Die bouwt zelf de descriptor-keten en laat
+// WR/RS/CS door de LCD_CAM-peripheral aansturen. espressif32@6.9.0 (Arduino 2.0.x)
+// is IDF 4.4: andere callback-signatuur en nog geen clk_src in de busconfig.
+template <class Pins, uint32_t PclkHz>
+struct EspLcdI80Engine {
+  struct State {
+    esp_lcd_i80_bus_handle_t  bus = nullptr;
+    esp_lcd_panel_io_handle_t io = nullptr;
+    volatile uint32_t queued = 0;
+    volatile uint32_t done   = 0;
+  };
+
+  static State& state() {
+    static State s;
+    return s;
+  }
+
+#if ESP_IDF_VERSION_MAJOR >= 5
+  static bool IRAM_ATTR on_color_done(esp_lcd_panel_io_handle_t, esp_lcd_panel_io_event_data_t*, void*) {
+#else
+  static bool IRAM_ATTR on_color_done(esp_lcd_panel_io_handle_t, void*, void*) {
+#endif
+    state().done = state().done + 1;
+    return false;
+  }
+
+  static void init(size_t max_transfer_bytes) {
+    // LCD_CAM heeft één i80-bus: een tweede esp_lcd_new_i80_bus faalt (en ESP_ERROR_CHECK aborteert)
+    if (state().io) return;
+
+    esp_lcd_i80_bus_config_t bus_cfg = {};
+    bus_cfg.dc_gpio_num = Pins::RS;
+    bus_cfg.wr_gpio_num = Pins::WR;
+#if ESP_IDF_VERSION_MAJOR >= 5
+    bus_cfg.clk_src     = LCD_CLK_SRC_PLL160M;   // 4.4 kiest zelf PLL160M
+#endif
+    for (int i = 0; i < 8; i++) bus_cfg.data_gpio_nums[i] = Pins::D0 + i;
+    bus_cfg.bus_width          = 8;
+    bus_cfg.max_transfer_bytes = max_transfer_bytes;
+    ESP_ERROR_CHECK(esp_lcd_new_i80_bus(&bus_cfg, &state().bus));
+
+    esp_lcd_panel_io_i80_config_t io_cfg = {};
+    io_cfg.cs_gpio_num         = Pins::CS;
+    io_cfg.pclk_hz             = PclkHz;
+    io_cfg.trans_queue_depth   = 4;
+    io_cfg.on_color_trans_done = on_color_done;
+    io_cfg.lcd_cmd_bits        = 8;
+    io_cfg.lcd_param_bits      = 8;
+    io_cfg.dc_levels.dc_idle_level  = 1;
+    io_cfg.dc_levels.dc_cmd_level   = 0;
+    io_cfg.dc_levels.dc_dummy_level = 0;
+    io_cfg.dc_levels.dc_data_level  = 1;
+    ESP_ERROR_CHECK(esp_lcd_new_panel_io_i80(state().bus, &io_cfg, &state().io));
+  }
+
+  static void deinit() {
+    if (!state().io) return;
+    wait_pending(0);
+    esp_lcd_panel_io_del(state().io);
+    esp_lcd_del_i80_bus(state().bus);
+    state().io  = nullptr;
+    state().bus = nullptr;
+    state().queued = state().done = 0;
+  }
+
+  static uint8_t* alloc(size_t bytes) {
+    return static_cast<uint8_t*>(heap_caps_malloc(bytes, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL));
+  }
+
+  static void tx_param(uint8_t cmd, const uint8_t* params, size_t n) {
+    esp_lcd_panel_io_tx_param(state().io, cmd, params, n);
+  }
+
+  static void tx_color(uint8_t cmd, const uint8_t* buf, size_t n) {
+    state().queued = state().queued + 1;
+    esp_lcd_panel_io_tx_color(state().io, cmd, buf, n);
+  }
+
+  static void wait_pending(uint32_t n) {
+    while (state().queued - state().done > n) {
+      // DMA loopt; spinnen is korter dan een tick
+    }
+  }
+};
+
+#else
+
+// Host: nep-DMA die elke tx_color als descriptor-keten vastlegt, zodat tests
+// chunking en bytevolgorde kunnen controleren. Transfers zijn direct klaar.
+struct DmaDescriptor {
+  std::vector<uint8_t> payload;   // length = payload.size()
+  bool eof;                       // laatste descriptor van de keten
+};
+
+struct DmaChain {
+  uint8_t cmd;
+  bool    color;                  // false = tx_param (CPU), true = tx_color (DMA)
+  std::vector<uint8_t> params;    // alleen bij tx_param
+  std::vector<DmaDescriptor> descs;
+};
+
+struct FakeDmaEngine {
+  struct State {
+    size_t max_transfer = 0;
+    int    inits        = 0;   // echte inits (zonder de no-op herhalingen)
+    bool   fail_alloc   = false;   // test: DMA-geheugen op
+    std::vector<DmaChain> chains;
+    std::vector<std::vector<uint8_t>> buffers;
+  };
+
+  static State& state() {
+    static State s;
+    return s;
+  }
+
+  static void reset() { state().chains.clear(); }
+
+  static void init(size_t max_transfer_bytes) {
+    if (state().max_transfer) return;
+    state().max_transfer = max_transfer_bytes;
+    state().inits++;
+  }
+
+  static void deinit() { state().max_transfer = 0; }
+
+  static uint8_t* alloc(size_t bytes) {
+    if (state().fail_alloc) return nullptr;
+    state().buffers.emplace_back(bytes);
+    return state().buffers.back().data();
+  }
+
+  static void tx_param(uint8_t cmd, const uint8_t* params, size_t n) {
+    DmaChain c{cmd, false, {}, {}};
+    if (params) c.params.assign(params, params + n);
+    state().chains.push_back(c);
+  }
+
+  static void tx_color(uint8_t cmd, const uint8_t* buf, size_t n) {
+    DmaChain c{cmd, true, {}, {}};
+    for (size_t off = 0; off < n; off += DMA_DESC_MAX) {
+      const size_t len = (n - off < DMA_DESC_MAX) ? (n - off) : DMA_DESC_MAX;
+      c.descs.push_back({std::vector<uint8_t>(buf + off, buf + off + len), off + len == n});
+    }
+    state().chains.push_back(c);
+  }
+
+  static void wait_pending(uint32_t) {}
+
+  // Alle pixelbytes achter elkaar, zoals ze over de bus zouden gaan
+  static std::vector<uint8_t> color_bytes() {
+    std::vector<uint8_t> out;
+    for (const auto& c : state().chains) {
+      if (!c.color) continue;
+      for (const auto& d : c.descs) out.insert(out.end(), d.payload.begin(), d.payload.end());
+    }
+    return out;
+  }
+};
+
+#endif
+
+} // namespace lcdbus
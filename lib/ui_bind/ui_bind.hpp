@@ -0,0 +1,46 @@
+// ui_bind.hpp - binding DisplayModel -> widgets: alleen bijwerken wat op het scherm verandert
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+namespace uibind {
+
+// Tellers per update-ronde (ui*_update); gereset door wie ze rapporteert
+struct Stats {
+  uint32_t fields;    // gecontroleerde velden
+  uint32_t changed;   // velden waarvan de widget is bijgewerkt
+};
+
+inline Stats& stats() {
+  static Stats s;
+  return s;
+}
+
+// Waarde op displayresolutie: scale 100 = 0.01 (V, A, F), scale 1 = hele eenheden.
+// Het label wordt uit dit getal geformatteerd (uifmt), zodat "gewijzigd" en "andere
+// tekst" altijd samenvallen (geen float-randgevallen zoals 1.005 -> "1.00" maar q = 101).
+inline int32_t quantize(float v, int32_t scale) {
+  return (int32_t)lroundf(v * (float)scale);
+}
+
+// Laatst getoonde waarde van één widget
+struct Field {
+  int32_t shown = 0;
+  bool    valid = false;   // false: widget heeft nog de standaardtekst
+
+  // true als de widget bijgewerkt moet worden (en onthoudt q)
+  bool set(int32_t q) {
+    Stats& s = stats();
+    s.fields++;
+    if (valid && q == shown) return false;
+    shown = q;
+    valid = true;
+    s.changed++;
+    return true;
+  }
+
+  void reset() { valid = false; }
+};
+
+} // namespace uibind
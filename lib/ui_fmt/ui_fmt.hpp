@@ -0,0 +1,107 @@
+// ui_fmt.hpp - fixed-point getallen en mm:ss naar tekst, zonder float-printf en zonder heap
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+namespace uifmt {
+
+// Schrijft in een buffer van de caller; kapt af zoals snprintf (altijd
+// nul-afgesloten als n > 0) en len() is de lengte die het had moeten worden.
+class Writer {
+public:
+  Writer(char* buf, size_t n) : buf_(buf), n_(n) {
+    if (n_ > 0) buf_[0] = '\0';
+  }
+
+  size_t len() const { return len_; }
+  bool truncated() const { return n_ == 0 || len_ >= n_; }
+
+  // Elk teken dat past krijgt meteen zijn afsluitende nul; wat niet past telt alleen mee
+  Writer& ch(char c) {
+    if (len_ + 1 < n_) {
+      buf_[len_] = c;
+      buf_[len_ + 1] = '\0';
+    }
+    len_++;
+    return *this;
+  }
+
+  Writer& str(const char* s) {
+    while (*s) ch(*s++);
+    return *this;
+  }
+
+  // Unsigned, minstens `digits` cijfers (voorloopnullen zoals %0Nu)
+  Writer& u32(uint32_t v, uint8_t digits = 1) {
+    char tmp[10];
+    int i = 0;
+    do {
+      tmp[i++] = (char)('0' + v % 10);
+      v /= 10;
+    } while (v != 0);
+    while (i < digits && i < (int)sizeof(tmp)) tmp[i++] = '0';
+    while (i > 0) ch(tmp[--i]);
+    return *this;
+  }
+
+  // Scaled integer met `in_dec` decimalen (mV = 3) als "[-]I.F" met `dec`
+  // decimalen, afgerond half-van-nul-af; width > 0 = rechts uitlijnen met spaties
+  Writer& fixed(int32_t v, uint8_t in_dec, uint8_t dec, uint8_t width = 0);
+
+  // Seconden als "mm:ss" (minuten minstens 2 cijfers, net als "%02u:%02u")
+  Writer& mmss(uint32_t sec) {
+    return u32(sec / 60, 2).ch(':').u32(sec % 60, 2);
+  }
+
+private:
+  char*  buf_;
+  size_t n_;
+  size_t len_ = 0;
+};
+
+constexpr uint32_t POW10[10] = {
+  1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u, 100000000u, 1000000000u,
+};
+
+inline Writer& Writer::fixed(int32_t v, uint8_t in_dec, uint8_t dec, uint8_t width) {
+  if (in_dec > 9) in_dec = 9;
+  if (dec > 9) dec = 9;
+
+  // Naar `dec` decimalen: afronden als er decimalen wegvallen, aanvullen als er bij komen
+  const bool neg = v < 0;
+  uint64_t a = neg ? (uint64_t)0 - (uint64_t)(int64_t)v : (uint64_t)v;
+  if (dec < in_dec) {
+    const uint32_t div = POW10[in_dec - dec];
+    a = (a + div / 2) / div;
+  } else {
+    a *= POW10[dec - in_dec];
+  }
+
+  const uint64_t unit  = POW10[dec];
+  const uint64_t whole = a / unit;
+  const uint32_t frac  = (uint32_t)(a % unit);
+  const bool     minus = neg && a != 0;   // -0.004 V met 2 decimalen wordt "0.00"
+
+  if (width > 0) {
+    // Breedte vooraf uitrekenen: teken + geheel deel + punt + decimalen
+    uint32_t w = (minus ? 1 : 0) + (dec ? dec + 1 : 0) + 1;
+    for (uint64_t t = whole; t >= 10; t /= 10) w++;
+    for (; w < width; w++) ch(' ');
+  }
+
+  if (minus) ch('-');
+  u32((uint32_t)whole);   // |int32| <= 2^31, dus het gehele deel past altijd
+  if (dec) ch('.').u32(frac, dec);
+  return *this;
+}
+
+// Losse aanroepen voor één getal; geven de gewenste lengte terug zoals snprintf
+inline size_t fixed(char* buf, size_t n, int32_t v, uint8_t in_dec, uint8_t dec, uint8_t width = 0) {
+  return Writer(buf, n).fixed(v, in_dec, dec, width).len();
+}
+
+inline size_t mmss(char* buf, size_t n, uint32_t sec) {
+  return Writer(buf, n).mmss(sec).len();
+}
+
+} // namespace uifmt
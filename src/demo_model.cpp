@@ -0,0 +1,92 @@
+// demo_model.cpp - demo-data voor de drie UI's (target en host-build)
+#include "demo_model.hpp"
+
+// Demo-curve (de logger levert straks een echte, veel langere curve)
+static const int16_t DEMO_CURVE[32] = {
+    98, 95, 93, 92, 91, 90, 89, 88,
+    87, 86, 84, 82, 80, 78, 75, 72,
+    70, 67, 63, 58, 52, 45, 38, 30,
+    25, 20, 15, 10, 7, 5, 3, 0
+};
+
+// Demo-only direction helpers (niet in model, puur animatie)
+static int   ui1_progress_dir = 1;  // +1 naar rechts, -1 naar links
+static float ui2_dir = 1.0f;
+static float ui3_dir = 1.0f;
+
+void demo_model_init(DisplayModel& m)
+{
+  // UI1: curve + startwaarden
+  m.ui1.curve      = DEMO_CURVE;
+  m.ui1.curve_len  = 32;
+  m.ui1.curve_rev  = 1;
+  m.ui1.view_first = 0;
+  m.ui1.view_len   = 0;
+
+  m.ui1.voltage_val      = 0.0f;
+  m.ui1.current_val      = 0.0f;
+  m.ui1.capacity_val     = 0.0f;
+  m.ui1.runtime_sec      = 0;
+  m.ui1.state_load       = true;
+  m.ui1.nominal_v_val    = 0.0f;
+  m.ui1.btn_capacity_val = 0.0f;
+  m.ui1.progress_index   = 0;
+
+  ui1_progress_dir = 1;
+
+  // UI2
+  m.ui2.set_voltage = 0.0f;
+  m.ui2.meas_ampere = 0.0f;
+  m.ui2.vmax        = 20.0f;
+  ui2_dir = 1.0f;
+
+  // UI3
+  m.ui3.set_ampere   = 0.0f;
+  m.ui3.meas_voltage = 0.0f;
+  m.ui3.imax         = 5.0f;
+  ui3_dir = 1.0f;
+}
+
+void demo_model_tick_1s(DisplayModel& m)
+{
+  // ---------------- UI1 ----------------
+  m.ui1.voltage_val += 0.05f;
+  if (m.ui1.voltage_val > 5.0f) m.ui1.voltage_val = 0.0f;
+
+  m.ui1.current_val += 0.02f;
+  if (m.ui1.current_val > 2.0f) m.ui1.current_val = 0.0f;
+
+  m.ui1.runtime_sec++;
+
+  m.ui1.capacity_val += 0.10f;
+  if (m.ui1.capacity_val > 10.0f) m.ui1.capacity_val = 0.0f;
+
+  m.ui1.state_load = !m.ui1.state_load;
+
+  // Cursor heen en weer over curve
+  m.ui1.progress_index += ui1_progress_dir;
+  const int last = (int)m.ui1.curve_len - 1;
+  if (m.ui1.progress_index >= last)                   { m.ui1.progress_index = last;                   ui1_progress_dir = -1; }
+  if (m.ui1.progress_index <= 0)                      { m.ui1.progress_index = 0;                      ui1_progress_dir =  1; }
+
+  // Buttons: nominal voltage & capacity laten lopen
+  m.ui1.nominal_v_val += 0.05f;
+  if (m.ui1.nominal_v_val > 5.0f) m.ui1.nominal_v_val = 0.0f;
+
+  m.ui1.btn_capacity_val += 0.10f;
+  if (m.ui1.btn_capacity_val > 10.0f) m.ui1.btn_capacity_val = 0.0f;
+
+  // ---------------- UI2 ----------------
+  m.ui2.set_voltage += 0.4f * ui2_dir;
+  if (m.ui2.set_voltage >= m.ui2.vmax) { m.ui2.set_voltage = m.ui2.vmax; ui2_dir = -1.0f; }
+  if (m.ui2.set_voltage <= 0.0f)       { m.ui2.set_voltage = 0.0f;       ui2_dir =  1.0f; }
+
+  m.ui2.meas_ampere = 0.2f + (m.ui2.set_voltage / m.ui2.vmax) * 1.8f;
+
+  // ---------------- UI3 ----------------
+  m.ui3.set_ampere += 0.25f * ui3_dir;
+  if (m.ui3.set_ampere >= m.ui3.imax) { m.ui3.set_ampere = m.ui3.imax; ui3_dir = -1.0f; }
+  if (m.ui3.set_ampere <= 0.0f)       { m.ui3.set_ampere = 0.0f;       ui3_dir =  1.0f; }
+
+  m.ui3.meas_voltage = 12.0f - (m.ui3.set_ampere / m.ui3.imax) * 6.0f;
+}
@@ -0,0 +1,6 @@
+#pragma once
+#include "ui_screens.hpp"
+
+// Demo-model: startwaarden en één seconde "simulatie" (puur animatie, geen meetdata)
+void demo_model_init(DisplayModel& m);
+void demo_model_tick_1s(DisplayModel& m);
@@ -0,0 +1,85 @@
+#include <Arduino.h>
+
+#include "ili9488_driver.hpp"
+#include "my_display.hpp"
+#include "display_backend.hpp"
+
+// Het LGFX-device uit my_display.hpp (was alleen extern gedeclareerd)
+LGFX gfx;
+
+// ---------------- EIGEN DRIVER ----------------
+static void ili_init_begin() {
+  if (!ili9488_init_begin()) {
+    Serial.println("[lcd] geen DMA-geheugen voor de i80 staging-buffers, paneel blijft leeg");
+  }
+}
+static bool ili_init_poll()  { return ili9488_init_poll(); }
+
+static void ili_push(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint8_t* px_map) {
+  ili9488_push_pixels(x, y, w, h, px_map);
+}
+
+static void ili_fill(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
+  ili9488_fill_area(x, y, w, h, color);
+}
+
+static void ili_release() { ili9488_release(); }
+
+const DisplayBackend backend_ili9488 = {
+  "ili9488", ili_init_begin, ili_init_poll, ili_push, ili_fill, ili_release,
+};
+
+// ---------------- LOVYANGFX ----------------
+// Bus_Parallel8 gebruikt op de S3 zelf LCD_CAM + DMA. LVGL rendert RGB565 little
+// endian, dus LovyanGFX moet swappen; in native-pixelmodus staat het al goed.
+#if defined(ILI9488_NATIVE_PIXELS)
+static constexpr bool LGFX_SWAP = false;
+#else
+static constexpr bool LGFX_SWAP = true;
+#endif
+
+static void lgfx_init_begin() {
+  // LovyanGFX wacht zelf de reset/sleep-out tijden af; niks om te overlappen
+  gfx.init();
+  gfx.setRotation(1);   // landscape 480x320, zelfde als ili9488_set_rotation(1)
+}
+
+static bool lgfx_init_poll() { return true; }
+
+static void lgfx_push(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint8_t* px_map) {
+  gfx.startWrite();
+  gfx.setAddrWindow(x, y, w, h);
+  gfx.pushPixelsDMA(reinterpret_cast<const uint16_t*>(px_map), (uint32_t)w * h, LGFX_SWAP);
+  gfx.waitDMA();
+  gfx.endWrite();
+}
+
+static void lgfx_fill(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
+  gfx.fillRect(x, y, w, h, color);
+}
+
+static void lgfx_release() { gfx.releaseBus(); }
+
+const DisplayBackend backend_lgfx = {
+  "lovyangfx", lgfx_init_begin, lgfx_init_poll, lgfx_push, lgfx_fill, lgfx_release,
+};
+
+// ---------------- SELECTIE ----------------
+#if defined(DISPLAY_BACKEND_LGFX)
+static const DisplayBackend* g_backend = &backend_lgfx;
+#else
+static const DisplayBackend* g_backend = &backend_ili9488;
+#endif
+
+const DisplayBackend& display_backend() { return *g_backend; }
+
+void display_backend_use(const DisplayBackend& b) { g_backend = &b; }
+
+void display_backend_select(const DisplayBackend& b) {
+  // Beide gebruiken dezelfde pinnen en (met ILI9488_TRANSPORT_I80) LCD_CAM: eerst de
+  // vorige loslaten, dan zet init de bus en GPIO-matrix voor zichzelf op
+  if (g_backend != &b) g_backend->release();
+  g_backend = &b;
+  b.init_begin();
+  while (!b.init_poll()) delay(1);
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <stdint.h>
+
+// Backend voor de LVGL-flush: eigen ILI9488-driver of LovyanGFX (LGFX gfx).
+// Compile-time standaard met -DDISPLAY_BACKEND_LGFX, runtime wisselen kan voor de benchmark.
+struct DisplayBackend {
+  const char* name;
+
+  // Init in twee delen zodat de wachttijden van het paneel met ander boot-werk
+  // kunnen overlappen: init_begin() start, init_poll() geeft true als het paneel klaar is
+  void (*init_begin)();
+  bool (*init_poll)();
+
+  // LVGL-pixels (RGB565 zoals LVGL rendert); keert terug als ze op het paneel staan
+  void (*push)(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint8_t* px_map);
+
+  // Eén kleur (RGB565 zoals LVGL hem ziet)
+  void (*fill)(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
+
+  // Bus vrijgeven voor de andere backend (beide willen LCD_CAM en dezelfde pinnen)
+  void (*release)();
+};
+
+extern const DisplayBackend backend_ili9488;
+extern const DisplayBackend backend_lgfx;
+
+// Actieve backend voor de flush
+const DisplayBackend& display_backend();
+
+// Backend actief maken zonder init (init_begin/init_poll doet de caller)
+void display_backend_use(const DisplayBackend& b);
+
+// Backend actief maken en blokkerend initialiseren (paneel opnieuw opzetten)
+void display_backend_select(const DisplayBackend& b);
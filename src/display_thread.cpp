@@ -3,9 +3,24 @@
 #include <Adafruit_AW9523.h>
 #include <lvgl.h>
 
+#include <atomic>
+#include <string.h>
+#include <esp_heap_caps.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+
 #include "ili9488_driver.hpp"
 #include "display_thread.hpp"
+#include "display_backend.hpp"
+#include "ili9488_strip_chart.hpp"
+#include "frame_prof.hpp"
 #include "ui_screens.hpp"
+#include "ui_theme.hpp"
+#include "ui_bind.hpp"
+#include "demo_model.hpp"
+#include "dirty_rects.hpp"
+#include "buf_tune.hpp"
 
 // ---------------- BACKLIGHT ----------------
 Adafruit_AW9523 aw;
@@ -13,6 +28,9 @@ constexpr uint8_t BL_PINS[] = {0, 1, 2, 3, 4, 5};
 
 static lv_display_t* disp = nullptr;
 
+constexpr uint16_t LCD_W = 480;
+constexpr uint16_t LCD_H = 320;
+
 // UI switch interval in ms
 constexpr uint32_t UI_SWITCH_INTERVAL_MS = 10000; // 10 seconds for demo
 
@@ -27,182 +45,1009 @@ static ActiveUI current_ui = ActiveUI::UI1;
 // ---------------- MODEL (single source of truth) ----------------
 static DisplayModel g_model;
 
-// Demo-only direction helpers (niet in model, puur animatie)
-static int   ui1_progress_dir = 1;  // +1 naar rechts, -1 naar links
-static float ui2_dir = 1.0f;
-static float ui3_dir = 1.0f;
+// ---------------- BACKLIGHT INIT ----------------
+static void backlight_init_and_on() {
+  Wire.begin(21, 19);
+  if (!aw.begin(0x58)) {
+    Serial.println("AW9523 niet gevonden!");
+    return;
+  }
+  Serial.println("AW9523 OK, backlight aan");
+  for (auto pin : BL_PINS) {
+    aw.pinMode(pin, AW9523_LED_MODE);
+    aw.analogWrite(pin, 255);
+  }
+}
 
-static void model_init(DisplayModel& m)
-{
-  // UI1: curve + startwaarden
-  m.ui1.curve_len = 32;
-  int16_t init_curve[32] = {
-      98, 95, 93, 92, 91, 90, 89, 88,
-      87, 86, 84, 82, 80, 78, 75, 72,
-      70, 67, 63, 58, 52, 45, 38, 30,
-      25, 20, 15, 10, 7, 5, 3, 0
-  };
-  for (int i = 0; i < 32; ++i) m.ui1.curve[i] = init_curve[i];
+// ---------------- ASYNC FLUSH ----------------
+// 1 = my_flush_cb zet het gebied in een queue en keert meteen terug; een aparte
+//     transfer-taak (core 0) pusht de pixels en meldt daarna flush-ready.
+//     LVGL rendert ondertussen al in het andere buffer.
+// 0 = synchrone flush zoals vroeger (handig om de meetwaarden te vergelijken)
+#ifndef DISPLAY_ASYNC_FLUSH
+#define DISPLAY_ASYNC_FLUSH 1
+#endif
 
-  m.ui1.voltage_val      = 0.0f;
-  m.ui1.current_val      = 0.0f;
-  m.ui1.capacity_val     = 0.0f;
-  m.ui1.runtime_sec      = 0;
-  m.ui1.state_load       = true;
-  m.ui1.nominal_v_val    = 0.0f;
-  m.ui1.btn_capacity_val = 0.0f;
-  m.ui1.progress_index   = 0;
+struct FlushJob {
+  lv_display_t* disp;
+  lv_area_t     area;
+  uint8_t*      px_map;
+  bool          last;     // laatste stripe van deze refresh
+  bool          ready;    // daarna lv_display_flush_ready (direct: pas na de laatste rechthoek)
+  uint16_t      stride;   // 0 = aaneengesloten, anders pixels per rij (rechthoek uit de framebuffer)
+};
 
-  ui1_progress_dir = 1;
+// Meting per frame: render- en transfertijd, en hoeveel daarvan tegelijk liep
+struct FlushStats {
+  uint32_t frame_start_us;
+  uint32_t frame_end_us;  // einde van de laatste transfer
+  uint32_t render_us;     // REFR_START..REFR_READY minus wachten op een vrij buffer
+  uint32_t wait_us;
+  uint32_t xfer_us;       // som van alle transfers
+  uint32_t flushes;
+  uint32_t px_rendered;   // som van de flush-gebieden
+  uint32_t px_pushed;     // wat de driver echt naar het paneel stuurde
+  uint16_t inv_areas;     // invalidaties die tot deze refresh leidden
+  volatile bool done;
+};
 
-  // UI2
-  m.ui2.set_voltage = 0.0f;
-  m.ui2.meas_ampere = 0.0f;
-  m.ui2.vmax        = 20.0f;
-  ui2_dir = 1.0f;
+static FlushStats g_flush_stats = {};
 
-  // UI3
-  m.ui3.set_ampere   = 0.0f;
-  m.ui3.meas_voltage = 0.0f;
-  m.ui3.imax         = 5.0f;
-  ui3_dir = 1.0f;
-}
+// -DDISPLAY_STATS=1: meetregels over serial tijdens het draaien. Standaard uit:
+// het UART-verkeer in de display-lus vertekent juist de tijden die gemeten worden.
+#ifndef DISPLAY_STATS
+#define DISPLAY_STATS 0
+#endif
 
-static void model_tick_1s(DisplayModel& m)
-{
-  // ---------------- UI1 ----------------
-  m.ui1.voltage_val += 0.05f;
-  if (m.ui1.voltage_val > 5.0f) m.ui1.voltage_val = 0.0f;
+// Boot-meting: alles in ms sinds power-on (millis())
+struct BootStats {
+  uint32_t task_start_ms;
+  uint32_t panel_ready_ms;   // init-tabel klaar
+  uint32_t init_block_ms;    // zo lang moest er echt op het paneel gewacht worden
+  uint32_t first_pixel_ms;   // eerste flush op het paneel
+  bool     reported;
+};
 
-  m.ui1.current_val += 0.02f;
-  if (m.ui1.current_val > 2.0f) m.ui1.current_val = 0.0f;
+static BootStats g_boot = {};
 
-  m.ui1.runtime_sec++;
+// ---------------- DISPLAY-LUS ----------------
+// 1 = LVGL-tick uit millis() (esp_timer) via lv_tick_set_cb; de taak slaapt tot
+//     de eerstvolgende LVGL-timer, model-tick of UI-wissel. Het model wordt in
+//     deze taak bijgewerkt, dus er is geen andere bron die hem eerder moet wekken.
+//     Na een model-update volgt de refresh meteen.
+// 0 = vaste 5 ms polling met lv_tick_inc(5) zoals vroeger (om te vergelijken)
+#ifndef DISPLAY_DEADLINE_LOOP
+#define DISPLAY_DEADLINE_LOOP 1
+#endif
 
-  m.ui1.capacity_val += 0.10f;
-  if (m.ui1.capacity_val > 10.0f) m.ui1.capacity_val = 0.0f;
+// Wakeups per seconde en update-tot-pixel latency: van ui*_update tot de laatste
+// pixel van de eerste refresh die daarna start
+struct LoopStats {
+  uint32_t wakeups;
+  uint32_t update_us;        // tijdstip van de laatste ui*_update
+  bool     update_pending;   // nog geen refresh gezien sinds update_us
+  uint32_t latency_us;
+  uint32_t latency_max_us;
+};
 
-  m.ui1.state_load = !m.ui1.state_load;
+static LoopStats g_loop = {};
 
-  // Cursor heen en weer over curve
-  m.ui1.progress_index += ui1_progress_dir;
-  if (m.ui1.progress_index >= (m.ui1.curve_len - 1)) { m.ui1.progress_index = m.ui1.curve_len - 1; ui1_progress_dir = -1; }
-  if (m.ui1.progress_index <= 0)                      { m.ui1.progress_index = 0;                      ui1_progress_dir =  1; }
+#if DISPLAY_DEADLINE_LOOP
+static uint32_t lv_tick_ms() {
+  return millis();
+}
 
-  // Buttons: nominal voltage & capacity laten lopen
-  m.ui1.nominal_v_val += 0.05f;
-  if (m.ui1.nominal_v_val > 5.0f) m.ui1.nominal_v_val = 0.0f;
+// Resterende ms tot since + period (0 als die al voorbij is)
+static uint32_t ms_until(uint32_t since, uint32_t period, uint32_t now) {
+  const uint32_t elapsed = now - since;
+  return elapsed < period ? period - elapsed : 0;
+}
+#endif
 
-  m.ui1.btn_capacity_val += 0.10f;
-  if (m.ui1.btn_capacity_val > 10.0f) m.ui1.btn_capacity_val = 0.0f;
+#if DISPLAY_ASYNC_FLUSH
+static QueueHandle_t         flush_queue    = nullptr;
+static SemaphoreHandle_t     flush_done_sem = nullptr;
+static std::atomic<uint32_t> flush_pending{0};
+#endif
 
-  // ---------------- UI2 ----------------
-  m.ui2.set_voltage += 0.4f * ui2_dir;
-  if (m.ui2.set_voltage >= m.ui2.vmax) { m.ui2.set_voltage = m.ui2.vmax; ui2_dir = -1.0f; }
-  if (m.ui2.set_voltage <= 0.0f)       { m.ui2.set_voltage = 0.0f;       ui2_dir =  1.0f; }
+// Wachten tot de laatste flush echt op het paneel staat (bus is dan vrij)
+static void wait_flush_idle() {
+#if DISPLAY_ASYNC_FLUSH
+  while (flush_pending.load() != 0) vTaskDelay(1);
+#endif
+}
 
-  m.ui2.meas_ampere = 0.2f + (m.ui2.set_voltage / m.ui2.vmax) * 1.8f;
+// ---------------- STRIP-CHART ----------------
+// -DDISPLAY_STRIP_CHART=1: UI1 toont een live spanningstrace via hardware scroll
+// (alleen met de eigen driver). De scrollband is de x-range van de chart over
+// de volle schermhoogte; alleen het plotgebied is van de strip, titel en
+// infolabels in de band blijven staan (zie Ili9488StripChart::push_around).
+#ifndef DISPLAY_STRIP_CHART
+#define DISPLAY_STRIP_CHART 0
+#endif
 
-  // ---------------- UI3 ----------------
-  m.ui3.set_ampere += 0.25f * ui3_dir;
-  if (m.ui3.set_ampere >= m.ui3.imax) { m.ui3.set_ampere = m.ui3.imax; ui3_dir = -1.0f; }
-  if (m.ui3.set_ampere <= 0.0f)       { m.ui3.set_ampere = 0.0f;       ui3_dir =  1.0f; }
+#if DISPLAY_STRIP_CHART
+static Ili9488StripChart g_strip;
 
-  m.ui3.meas_voltage = 12.0f - (m.ui3.set_ampere / m.ui3.imax) * 6.0f;
+static void strip_begin() {
+  int x, y, w, h;
+  ui1_chart_area(x, y, w, h);
+  wait_flush_idle();
+  g_strip.begin(x, w, y + 1, h - 2,
+                lv_color_to_u16(lv_color_hex(0xEDBE0E)), 0x0000);   // kleuren van de UI1-curve
 }
 
-// ---------------- BACKLIGHT INIT ----------------
-static void backlight_init_and_on() {
-  Wire.begin(21, 19);
-  if (!aw.begin(0x58)) {
-    Serial.println("AW9523 niet gevonden!");
+static void strip_end() {
+  if (!g_strip.active) return;
+  wait_flush_idle();
+  g_strip.end();
+}
+
+static void strip_sample(const DisplayModel& m) {
+  if (!g_strip.active) return;
+  wait_flush_idle();   // bus delen met de flush-taak
+  g_strip.push((int32_t)(m.ui1.voltage_val * 1000.0f), 0, 5000);
+
+  // De scroll schoof ook de band boven en onder het plot één pixel op: opnieuw
+  // laten renderen, push_around zet het terug op zijn plaats (~44k px per sample)
+  const lv_area_t above = { (int32_t)g_strip.x0, 0,
+                            (int32_t)(g_strip.x0 + g_strip.w - 1), (int32_t)g_strip.y0 - 1 };
+  const lv_area_t below = { (int32_t)g_strip.x0, (int32_t)(g_strip.y0 + g_strip.h),
+                            (int32_t)(g_strip.x0 + g_strip.w - 1), (int32_t)ili9488_height() - 1 };
+  lv_obj_invalidate_area(lv_screen_active(), &above);
+  lv_obj_invalidate_area(lv_screen_active(), &below);
+}
+#endif
+
+// ---------------- RENDER-MODUS ----------------
+// PARTIAL: stripes van DISPLAY_DRAW_BUF_LINES (standaard 2x10 in interne RAM), LVGL
+//          rendert en flusht per stripe. De benchmark zoekt de beste maat (buftune).
+// DIRECT:  één 480x320 framebuffer in PSRAM (300 KB); LVGL rendert alleen wat
+//          geïnvalideerd is, na de refresh gaan de samengevoegde gebieden naar het
+//          paneel. Zonder PSRAM blijft het PARTIAL.
+enum class PortMode : uint8_t { PARTIAL, DIRECT };
+
+#ifndef DISPLAY_DIRECT_MODE
+#define DISPLAY_DIRECT_MODE 0
+#endif
+
+#ifndef DISPLAY_DRAW_BUF_LINES
+#define DISPLAY_DRAW_BUF_LINES 10
+#endif
+#ifndef DISPLAY_DRAW_BUF_COUNT
+#define DISPLAY_DRAW_BUF_COUNT 2
+#endif
+#ifndef DISPLAY_DRAW_BUF_PSRAM
+#define DISPLAY_DRAW_BUF_PSRAM 0
+#endif
+
+static constexpr buftune::Config DRAW_BUF_DEFAULT = {
+  DISPLAY_DRAW_BUF_LINES, DISPLAY_DRAW_BUF_COUNT, DISPLAY_DRAW_BUF_PSRAM != 0
+};
+
+static buftune::Config g_buf_cfg = {};
+static uint8_t*        g_buf[2]  = {};
+
+// Flush uit PSRAM (framebuffer of PSRAM-stripes) gaat per band via interne RAM
+static constexpr size_t BOUNCE_BYTES = (size_t)LCD_W * 10 * 2;
+static uint8_t*         g_bounce     = nullptr;
+
+static constexpr size_t FB_BYTES = (size_t)LCD_W * LCD_H * 2;
+static uint8_t*  g_fb        = nullptr;
+static PortMode  g_port_mode = PortMode::PARTIAL;
+
+// Gebieden van één DIRECT-refresh; vol = samenvoegen met de goedkoopste
+static dirtyrect::Coalescer<16> g_dirty;
+
+// Backend verwacht bytes zoals LVGL ze rendert (zie Ili9488PixelFormat)
+static void push_area(int32_t x, int32_t y, int32_t w, int32_t h, const uint8_t* px) {
+#if DISPLAY_STRIP_CHART
+  if (g_strip.active) {
+    g_strip.push_around(x, y, w, h, px);
     return;
   }
-  Serial.println("AW9523 OK, backlight aan");
-  for (auto pin : BL_PINS) {
-    aw.pinMode(pin, AW9523_LED_MODE);
-    aw.analogWrite(pin, 255);
+#endif
+  display_backend().push(x, y, w, h, px);
+}
+
+static void flush_run(const FlushJob& job) {
+  int32_t w = job.area.x2 - job.area.x1 + 1;
+  int32_t h = job.area.y2 - job.area.y1 + 1;
+
+  const uint32_t t0 = micros();
+  const Ili9488FillStats& fs = ili9488_fill_stats();
+  const uint32_t px_before = fs.px_streamed + fs.px_solid;
+
+  if (job.stride == 0) {
+    push_area(job.area.x1, job.area.y1, w, h, (const uint8_t*)job.px_map);
+  } else {
+    // Uit PSRAM: per band via de bounce-buffer (interne RAM) naar de bus
+    uint8_t* bounce = g_bounce;
+    const int32_t rows = (int32_t)(BOUNCE_BYTES / 2) / w;
+    for (int32_t y = 0; y < h; y += rows) {
+      const int32_t n = (h - y < rows) ? h - y : rows;
+      for (int32_t r = 0; r < n; r++) {
+        memcpy(bounce + (size_t)r * w * 2, job.px_map + (size_t)(y + r) * job.stride * 2, (size_t)w * 2);
+      }
+      push_area(job.area.x1, job.area.y1 + y, w, n, bounce);
+    }
+  }
+
+  const uint32_t t1 = micros();
+  g_flush_stats.xfer_us += t1 - t0;
+  g_flush_stats.flushes++;
+  g_flush_stats.px_rendered += (uint32_t)(w * h);
+  g_flush_stats.px_pushed   += (&display_backend() == &backend_ili9488)
+                                 ? (fs.px_streamed + fs.px_solid) - px_before
+                                 : (uint32_t)(w * h);
+  if (g_boot.first_pixel_ms == 0) g_boot.first_pixel_ms = millis();
+  if (job.last) {
+    g_flush_stats.frame_end_us = t1;
+    g_flush_stats.done = true;
+  }
+
+  if (job.ready) lv_display_flush_ready(job.disp);
+
+#if DISPLAY_ASYNC_FLUSH
+  flush_pending--;
+  xSemaphoreGive(flush_done_sem);
+#endif
+}
+
+#if DISPLAY_ASYNC_FLUSH
+// Transfer-taak: voert flush-jobs uit zodra LVGL ze aanlevert
+static void flush_task(void*) {
+  FlushJob job;
+  while (true) {
+    if (xQueueReceive(flush_queue, &job, portMAX_DELAY) == pdTRUE) {
+      flush_run(job);
+    }
+  }
+}
+
+// LVGL moet wachten op een vrij buffer: blokkeren i.p.v. busy-loopen
+static void my_flush_wait_cb(lv_display_t*) {
+  const uint32_t t0 = micros();
+  while (flush_pending.load() != 0) {
+    xSemaphoreTake(flush_done_sem, pdMS_TO_TICKS(1));
+  }
+  g_flush_stats.wait_us += micros() - t0;
+}
+#endif
+
+// ---------------- PROFILER ----------------
+// -DDISPLAY_PROFILER=1: per refresh een frameprof::FrameRecord in een lock-free
+// ring; een telemetrie-taak streamt ze binair over serial (tussen de tekst door).
+// Decoderen op de host: test/gtest/frame_prof_decode.
+#ifndef DISPLAY_PROFILER
+#define DISPLAY_PROFILER 0
+#endif
+
+static volatile uint16_t g_inv_areas   = 0;   // sinds de vorige REFR_START
+static volatile bool     g_refr_seen   = false;
+static volatile bool     g_refr_flushed = false;  // flush_cb sinds REFR_START (ook async: LVGL-kant)
+static uint32_t          g_frame_seq   = 0;
+static uint32_t          g_frame_timer_us = 0;  // lv_timer_handler() van de refresh
+
+#if DISPLAY_PROFILER
+static frameprof::SpscRing<frameprof::FrameRecord, 64> g_prof_ring;
+
+static void telemetry_task(void*) {
+  uint8_t buf[frameprof::RECORD_BYTES];
+  frameprof::FrameRecord r;
+  while (true) {
+    while (g_prof_ring.pop(r)) {
+      Serial.write(buf, frameprof::encode(r, buf));
+    }
+    vTaskDelay(pdMS_TO_TICKS(20));
+  }
+}
+
+static void profiler_push(const FlushStats& s) {
+  frameprof::FrameRecord r;
+  r.seq         = g_frame_seq++;
+  r.t_ms        = s.frame_start_us / 1000;
+  r.inv_areas   = s.inv_areas;
+  r.flushes     = (uint16_t)s.flushes;
+  r.px_rendered = s.px_rendered;
+  r.px_pushed   = s.px_pushed;
+  r.timer_us    = g_frame_timer_us;
+  r.render_us   = s.render_us;
+  r.flush_us    = s.xfer_us;
+  r.wait_us     = s.wait_us;
+  g_prof_ring.push(r);   // vol: record valt weg (gat in seq), display-taak wacht nooit
+}
+#endif
+
+static volatile uint32_t g_inv_px = 0;   // geïnvalideerde pixels, gereset door bind_report
+
+static void invalidate_event_cb(lv_event_t* e) {
+  g_inv_areas = g_inv_areas + 1;
+  const lv_area_t* a = lv_event_get_invalidated_area(e);
+  if (a) g_inv_px = g_inv_px + (uint32_t)(lv_area_get_width(a) * lv_area_get_height(a));
+}
+
+static void refr_event_cb(lv_event_t* e) {
+  static uint32_t refr_start = 0;
+
+  if (lv_event_get_code(e) == LV_EVENT_REFR_START) {
+    refr_start = micros();
+    g_flush_stats = {};
+    g_flush_stats.frame_start_us = refr_start;
+    g_flush_stats.inv_areas = g_inv_areas;
+    g_inv_areas = 0;
+    g_refr_seen = true;
+    g_refr_flushed = false;
+  } else {
+    const uint32_t busy = micros() - refr_start;
+    g_flush_stats.render_us = busy - g_flush_stats.wait_us;
+
+    // Update zonder zichtbare wijziging: er komt geen flush, dus ook geen latency
+    if (!g_refr_flushed && g_loop.update_pending && (int32_t)(refr_start - g_loop.update_us) >= 0) {
+      g_loop.update_pending = false;
+    }
+  }
+}
+
+static void flush_stats_report() {
+  if (!g_flush_stats.done) return;
+  g_flush_stats.done = false;
+
+  const FlushStats s = g_flush_stats;
+
+  if (g_loop.update_pending && (int32_t)(s.frame_start_us - g_loop.update_us) >= 0) {
+    g_loop.update_pending = false;
+    g_loop.latency_us = s.frame_end_us - g_loop.update_us;
+    if (g_loop.latency_us > g_loop.latency_max_us) g_loop.latency_max_us = g_loop.latency_us;
+  }
+
+#if DISPLAY_PROFILER
+  profiler_push(s);   // binaire records i.p.v. de tekstregel
+#elif DISPLAY_STATS
+  const uint32_t frame_us = s.frame_end_us - s.frame_start_us;
+  const int32_t  overlap  = (int32_t)(s.render_us + s.xfer_us) - (int32_t)frame_us;
+
+  Serial.printf("[flush] %s render=%lu us xfer=%lu us frame=%lu us overlap=%ld us (%lu flushes)\n",
+                DISPLAY_ASYNC_FLUSH ? "async" : "sync",
+                (unsigned long)s.render_us, (unsigned long)s.xfer_us,
+                (unsigned long)frame_us, (long)(overlap > 0 ? overlap : 0),
+                (unsigned long)s.flushes);
+#endif
+}
+
+static void boot_report() {
+  if (g_boot.reported || g_boot.first_pixel_ms == 0) return;
+  g_boot.reported = true;
+
+  Serial.printf("[boot] task=%lu ms panel_ready=%lu ms first_pixel=%lu ms (init blocked %lu ms, table min %lu ms)\n",
+                (unsigned long)g_boot.task_start_ms, (unsigned long)g_boot.panel_ready_ms,
+                (unsigned long)g_boot.first_pixel_ms, (unsigned long)g_boot.init_block_ms,
+                (unsigned long)ili9488_init_min_ms());
+}
+
+// Eén regel per model-tick: wakeups sinds de vorige en de latency van de vorige update
+static void loop_report(uint32_t elapsed_ms) {
+  Serial.printf("[loop] %s wakeups=%lu/s latency=%lu us max=%lu us\n",
+                DISPLAY_DEADLINE_LOOP ? "deadline" : "poll5ms",
+                (unsigned long)(elapsed_ms ? g_loop.wakeups * 1000UL / elapsed_ms : 0),
+                (unsigned long)g_loop.latency_us, (unsigned long)g_loop.latency_max_us);
+}
+
+// ---------------- UI-WISSEL ----------------
+// Schermen staan klaar (ui_screens_create bij boot); een wissel is lv_screen_load
+// + één volledige refresh. Gemeten tot de laatste pixel op het paneel staat.
+#ifndef UI_SWITCH_ANIM_MS
+#define UI_SWITCH_ANIM_MS 0   // >0: fade-in i.p.v. directe wissel
+#endif
+
+static void ui_show(ActiveUI ui) {
+  switch (ui) {
+    case ActiveUI::UI1: ui1_show(); ui1_update(g_model); break;
+    case ActiveUI::UI2: ui2_show(); ui2_update(g_model); break;
+    case ActiveUI::UI3: ui3_show(); ui3_update(g_model); break;
+  }
+}
+
+static uint32_t ui_switch_us(ActiveUI ui) {
+  wait_flush_idle();
+  const uint32_t t0 = micros();
+  lv_lock();
+  ui_show(ui);
+  lv_refr_now(disp);
+  lv_unlock();
+  wait_flush_idle();
+  return micros() - t0;
+}
+
+static void mem_report(const char* tag, uint32_t us) {
+  lv_mem_monitor_t mon;
+  lv_mem_monitor(&mon);
+  Serial.printf("[switch] %s %lu us pool used=%u%% frag=%u%% free=%lu biggest=%lu\n",
+                tag, (unsigned long)us, (unsigned)mon.used_pct, (unsigned)mon.frag_pct,
+                (unsigned long)mon.free_size, (unsigned long)mon.free_biggest_size);
+}
+
+// Per model-tick: welke widgets ui*_update echt bijwerkte en hoeveel pixels dat
+// invalideerde (vóór LVGL de gebieden samenvoegt)
+static void bind_report(ActiveUI ui) {
+  static const char* const names[] = {"UI1", "UI2", "UI3"};
+  uibind::Stats& st = uibind::stats();
+  Serial.printf("[bind] %s fields=%lu changed=%lu inv_px=%lu\n",
+                names[static_cast<uint8_t>(ui)],
+                (unsigned long)st.fields, (unsigned long)st.changed, (unsigned long)g_inv_px);
+  st = {};
+  g_inv_px = 0;
+}
+
+// Effen-vlak statistiek per scherm, gerapporteerd vlak voor het wisselen
+static void fill_stats_report(ActiveUI ui) {
+  static const char* const names[] = {"UI1", "UI2", "UI3"};
+  Ili9488FillStats& st = ili9488_fill_stats();
+  const uint32_t px = st.px_streamed + st.px_solid;
+
+  Serial.printf("[fill] %s areas=%lu solid=%lu px=%lu solid_px=%lu (%lu%%)",
+                names[static_cast<uint8_t>(ui)],
+                (unsigned long)st.areas, (unsigned long)st.solid_areas,
+                (unsigned long)px, (unsigned long)st.px_solid,
+                (unsigned long)(px ? (100ULL * st.px_solid / px) : 0));
+  // WR-only strobes besparen alleen GPIO-stores in de bit-bang transport
+  if (LcdTransport::kWrOnlyFill) {
+    Serial.printf(" wr_only_px=%lu stores_saved=%lu",
+                  (unsigned long)st.px_strobe, (unsigned long)st.stores_saved());
   }
+  Serial.println();
+  st = {};
 }
 
 // ---------------- LVGL DISPLAY PORT ----------------
+static void flush_submit(const FlushJob& job) {
+#if DISPLAY_ASYNC_FLUSH
+  // Niet wachten: transfer-taak meldt flush-ready als de pixels op het paneel staan
+  flush_pending++;
+  xQueueSend(flush_queue, &job, portMAX_DELAY);
+#else
+  flush_run(job);
+#endif
+}
+
+// DIRECT: px_map is de hele framebuffer en staat na elk gebied al goed. Gebieden
+// verzamelen, na het laatste samenvoegen en versturen; LVGL mag pas weer in de
+// framebuffer tekenen als de laatste rechthoek op het paneel staat.
+static void flush_direct(lv_display_t* disp_drv, const lv_area_t* area, uint8_t* fb) {
+  g_dirty.add({ (int16_t)area->x1, (int16_t)area->y1, (int16_t)area->x2, (int16_t)area->y2 });
+  if (!lv_display_flush_is_last(disp_drv)) {
+    lv_display_flush_ready(disp_drv);
+    return;
+  }
+
+  const int n = g_dirty.coalesce();
+  for (int i = 0; i < n; i++) {
+    const dirtyrect::Rect& r = g_dirty.rects[i];
+    FlushJob job = { disp_drv, { r.x1, r.y1, r.x2, r.y2 },
+                     fb + ((size_t)r.y1 * LCD_W + r.x1) * 2, i == n - 1, i == n - 1, LCD_W };
+    flush_submit(job);
+  }
+  g_dirty.clear();
+}
+
 static void my_flush_cb(lv_display_t* disp_drv, const lv_area_t* area, uint8_t* px_map) {
-  int32_t w = area->x2 - area->x1 + 1;
-  int32_t h = area->y2 - area->y1 + 1;
+  g_refr_flushed = true;
+  if (g_port_mode == PortMode::DIRECT) {
+    flush_direct(disp_drv, area, px_map);
+    return;
+  }
+  const uint16_t stride = g_buf_cfg.psram ? (uint16_t)(area->x2 - area->x1 + 1) : 0;
+  FlushJob job = { disp_drv, *area, px_map, lv_display_flush_is_last(disp_drv), true, stride };
+  flush_submit(job);
+}
 
-  // Driver verwacht bytes (RGB565 little-endian)
-  ili9488_push_pixels(area->x1, area->y1, w, h, (const uint8_t*)px_map);
+static void* buf_alloc(size_t n, bool psram) {
+  return heap_caps_malloc(n, psram ? (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+                                   : (MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA));
+}
 
-  lv_display_flush_ready(disp_drv);
+static void draw_bufs_free() {
+  heap_caps_free(g_buf[0]);
+  heap_caps_free(g_buf[1]);
+  g_buf[0] = g_buf[1] = nullptr;
+  g_buf_cfg = {};
 }
 
-static void lvgl_port_init() {
-  const uint16_t hor_res = 480;
-  const uint16_t ver_res = 320;
+// Nieuwe draw-buffers volgens cfg in out; de huidige blijven staan, LVGL rendert
+// daar nog in tot lv_display_set_buffers. false: niets gealloceerd (behalve bounce).
+static bool draw_bufs_alloc(const buftune::Config& cfg, uint8_t* (&out)[2]) {
+  out[0] = out[1] = nullptr;
+  if (cfg.psram && !g_bounce) g_bounce = (uint8_t*)buf_alloc(BOUNCE_BYTES, false);
+  if (cfg.psram && !g_bounce) return false;
+
+  const size_t bytes = (size_t)LCD_W * cfg.lines * 2;
+  for (int i = 0; i < cfg.buffers; i++) {
+    out[i] = (uint8_t*)buf_alloc(bytes, cfg.psram);
+    if (!out[i]) {
+      heap_caps_free(out[0]);
+      out[0] = out[1] = nullptr;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Geheugen van de huidige buffers (inclusief bounce waar die nodig is)
+static void port_ram(uint32_t& internal, uint32_t& psram) {
+  if (g_port_mode == PortMode::DIRECT) {
+    internal = BOUNCE_BYTES;
+    psram    = FB_BYTES;
+    return;
+  }
+  const uint32_t bytes = buftune::ram_bytes(g_buf_cfg, LCD_W);
+  internal = g_buf_cfg.psram ? BOUNCE_BYTES : bytes;
+  psram    = g_buf_cfg.psram ? bytes : 0;
+}
+
+// Buffers en render-modus wisselen (ook tijdens het draaien, voor de benchmark).
+// Eerst de nieuwe buffers, dan pas de oude vrijgeven: lukt de allocatie niet,
+// dan false en blijven modus en buffers zoals ze waren. PARTIAL gebruikt `bufs`.
+static bool lvgl_port_set_mode(PortMode mode, const buftune::Config& bufs = DRAW_BUF_DEFAULT) {
+  wait_flush_idle();
+
+  if (mode == PortMode::DIRECT) {
+    if (!g_bounce) g_bounce = (uint8_t*)buf_alloc(BOUNCE_BYTES, false);
+    uint8_t* fb = g_fb ? g_fb : (uint8_t*)buf_alloc(FB_BYTES, true);
+    if (!fb || !g_bounce) {
+      if (fb != g_fb) heap_caps_free(fb);
+      Serial.println("[port] geen PSRAM voor de framebuffer");
+      return false;
+    }
+    lv_display_set_buffers(disp, fb, nullptr, FB_BYTES, LV_DISPLAY_RENDER_MODE_DIRECT);
+    g_fb = fb;
+    draw_bufs_free();
+  } else {
+    uint8_t* buf[2];
+    if (!draw_bufs_alloc(bufs, buf)) {
+      Serial.printf("[port] geen geheugen voor %ux%u draw-buffers (%s)\n",
+                    bufs.buffers, bufs.lines, bufs.psram ? "psram" : "intern");
+      return false;
+    }
+    lv_display_set_buffers(disp, buf[0], buf[1], (uint32_t)LCD_W * bufs.lines * 2,
+                           LV_DISPLAY_RENDER_MODE_PARTIAL);
+    draw_bufs_free();
+    heap_caps_free(g_fb);
+    g_fb = nullptr;
+    g_buf[0] = buf[0];
+    g_buf[1] = buf[1];
+    g_buf_cfg = bufs;
+  }
+
+  g_dirty.clear();
+  g_port_mode = mode;
+
+  // Framebuffer-inhoud is onbekend: alles opnieuw
+  lv_obj_invalidate(lv_screen_active());
+  return true;
+}
 
-  disp = lv_display_create(hor_res, ver_res);
+// Modus uit de build-vlaggen; zonder PSRAM voor DIRECT wordt het PARTIAL
+static void lvgl_port_set_default() {
+  if (lvgl_port_set_mode(DISPLAY_DIRECT_MODE ? PortMode::DIRECT : PortMode::PARTIAL)) return;
+  if (DISPLAY_DIRECT_MODE) lvgl_port_set_mode(PortMode::PARTIAL);
+}
+
+static void lvgl_port_init() {
+  disp = lv_display_create(LCD_W, LCD_H);
 
+#if defined(ILI9488_NATIVE_PIXELS)
+  // Render direct in paneelvolgorde (big endian); inversie doet het paneel (INVON)
+  lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565_SWAPPED);
+#else
   lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+#endif
   lv_display_set_flush_cb(disp, my_flush_cb);
 
-  static const uint16_t DRAW_BUF_LINES = 10;
-  static lv_color_t buf1[480 * DRAW_BUF_LINES];
-  static lv_color_t buf2[480 * DRAW_BUF_LINES];
-  lv_display_set_buffers(disp, buf1, buf2, sizeof(buf1), LV_DISPLAY_RENDER_MODE_PARTIAL);
+  lvgl_port_set_default();
+
+#if LV_DRAW_SW_DRAW_UNIT_CNT > 1
+  // -DDISPLAY_DUAL_CORE=1: elke stripe in tegels, één per draw unit, zodat beide
+  // cores tegelijk aan hetzelfde frame renderen
+  lv_display_set_tile_cnt(disp, LV_DRAW_SW_DRAW_UNIT_CNT);
+#endif
+
+  lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_REFR_START, nullptr);
+  lv_display_add_event_cb(disp, refr_event_cb, LV_EVENT_REFR_READY, nullptr);
+  lv_display_add_event_cb(disp, invalidate_event_cb, LV_EVENT_INVALIDATE_AREA, nullptr);
+
+#if DISPLAY_ASYNC_FLUSH
+  // Eén job tegelijk: met 2 buffers wacht LVGL zelf tot de vorige flush klaar is
+  flush_queue    = xQueueCreate(1, sizeof(FlushJob));
+  flush_done_sem = xSemaphoreCreateBinary();
+  lv_display_set_flush_wait_cb(disp, my_flush_wait_cb);
+
+  // Transfer op core 0 (loop() doet daar niks), LVGL rendert op core 1
+  xTaskCreatePinnedToCore(flush_task, "FlushTask", 4096, nullptr, 2, nullptr, 0);
+#endif
+
+#if DISPLAY_PROFILER
+  // Laagste prioriteit op core 0: serial mag de flush nooit ophouden
+  xTaskCreatePinnedToCore(telemetry_task, "ProfTask", 2048, nullptr, 1, nullptr, 0);
+#endif
 }
 
+// ---------------- BENCHMARK ----------------
+// -DDISPLAY_BENCHMARK=1: na het opstarten elke backend meten en over serial
+// rapporteren, daarna gewoon verder met de standaard backend.
+#ifndef DISPLAY_BENCHMARK
+#define DISPLAY_BENCHMARK 0
+#endif
+
+#if DISPLAY_BENCHMARK
+// Volledige UI-refresh: alles invalideren en meteen renderen + flushen
+static uint32_t bench_refresh_us() {
+  wait_flush_idle();
+  lv_obj_invalidate(lv_screen_active());
+  const uint32_t t0 = micros();
+  lv_refr_now(disp);
+  wait_flush_idle();
+  return micros() - t0;
+}
+
+// Eén model-tick: ui*_update + refresh, tot de laatste pixel op het paneel staat
+static uint32_t bench_update_us(ActiveUI ui) {
+  wait_flush_idle();
+  demo_model_tick_1s(g_model);
+  const uint32_t t0 = micros();
+  switch (ui) {
+    case ActiveUI::UI1: ui1_update(g_model); break;
+    case ActiveUI::UI2: ui2_update(g_model); break;
+    case ActiveUI::UI3: ui3_update(g_model); break;
+  }
+  lv_refr_now(disp);
+  wait_flush_idle();
+  return micros() - t0;
+}
+
+static void benchmark_backend(const DisplayBackend& b) {
+  constexpr int      REPS   = 10;
+  constexpr uint16_t STRIPE = 10;
+  static uint8_t stripe[480 * STRIPE * 2];
+  for (size_t i = 0; i < sizeof(stripe); i++) stripe[i] = (uint8_t)(i * 31);
+
+  display_backend_select(b);
+
+  // Full-screen fill (zwart/wit om en om)
+  uint32_t t0 = micros();
+  for (int r = 0; r < REPS; r++) b.fill(0, 0, 480, 320, (r & 1) ? 0xFFFF : 0x0000);
+  const uint32_t fill_us = (micros() - t0) / REPS;
+
+  // Stripe-flush: 32 stripes van 480x10 = één frame uit een niet-effen buffer
+  t0 = micros();
+  for (int r = 0; r < REPS; r++) {
+    for (uint16_t y = 0; y < 320; y += STRIPE) b.push(0, y, 480, STRIPE, stripe);
+  }
+  const uint32_t stripe_us = (micros() - t0) / REPS;
+
+  // UI-refresh per scherm (renderen + flushen via deze backend)
+  uint32_t ui_us[3] = {};
+  for (int ui = 0; ui < 3; ui++) {
+    switch (ui) {
+      case 0: ui_show(ActiveUI::UI1); break;
+      case 1: ui_show(ActiveUI::UI2); break;
+      case 2: ui_show(ActiveUI::UI3); break;
+    }
+    bench_refresh_us();   // eerste keer: opbouw, niet meetellen
+    uint32_t sum = 0;
+    for (int r = 0; r < REPS; r++) sum += bench_refresh_us();
+    ui_us[ui] = sum / REPS;
+  }
+
+  Serial.printf("[bench] %-9s fill=%lu us stripe-frame=%lu us ui1=%lu us ui2=%lu us ui3=%lu us\n",
+                b.name, (unsigned long)fill_us, (unsigned long)stripe_us,
+                (unsigned long)ui_us[0], (unsigned long)ui_us[1], (unsigned long)ui_us[2]);
+}
+
+// UI-wissels: opnieuw opbouwen (oude gedrag) tegen persistente schermen
+static void benchmark_switch(bool persistent) {
+  constexpr int SWITCHES = 30;
+  ui_screens_set_persistent(persistent);
+  if (persistent) ui_screens_create();
+
+  uint32_t sum = 0, worst = 0;
+  for (int i = 0; i < SWITCHES; i++) {
+    const uint32_t us = ui_switch_us(static_cast<ActiveUI>(i % 3));
+    sum += us;
+    if (us > worst) worst = us;
+  }
+  char tag[40];
+  snprintf(tag, sizeof(tag), "%s avg (max %lu us)", persistent ? "persistent" : "rebuild",
+           (unsigned long)worst);
+  mem_report(tag, sum / SWITCHES);
+}
+
+// LVGL-heap en volledige refresh per scherm: lokale stijlen per object (oude
+// gedrag) tegen de gedeelde ui_theme-stijlen. Eindigt met gedeelde stijlen.
+static void benchmark_styles(bool shared) {
+  constexpr int REPS = 10;
+  ui_screens_reset();
+  ui_theme_set_shared(shared);
+
+  for (int ui = 0; ui < 3; ui++) {
+    lv_mem_monitor_t mon0, mon1;
+    lv_mem_monitor(&mon0);
+    ui_show(static_cast<ActiveUI>(ui));
+    lv_mem_monitor(&mon1);
+
+    bench_refresh_us();   // eerste keer niet meetellen
+    uint32_t sum = 0;
+    for (int r = 0; r < REPS; r++) sum += bench_refresh_us();
+
+    Serial.printf("[style] %s UI%d heap=%ld B refresh=%lu us\n", shared ? "shared" : "local ",
+                  ui + 1, (long)mon0.free_size - (long)mon1.free_size, (unsigned long)(sum / REPS));
+  }
+}
+
+// PARTIAL tegen DIRECT per scherm: geheugen voor de buffers, volledige refresh en
+// een model-tick (alleen wat ui*_update invalideert, daar verschilt DIRECT het meest)
+static void benchmark_port_mode(PortMode mode) {
+  constexpr int REPS = 10;
+  if (!lvgl_port_set_mode(mode)) return;
+  const bool direct = mode == PortMode::DIRECT;
+
+  uint32_t int_bytes, ps_bytes;
+  port_ram(int_bytes, ps_bytes);
+  const size_t ps_free = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+
+  for (int ui = 0; ui < 3; ui++) {
+    const ActiveUI a = static_cast<ActiveUI>(ui);
+    ui_show(a);
+    bench_refresh_us();   // eerste keer niet meetellen
+    uint32_t full = 0;
+    for (int r = 0; r < REPS; r++) full += bench_refresh_us();
+
+    uint32_t upd = 0, px = 0, rects = 0;
+    for (int r = 0; r < REPS; r++) {
+      upd   += bench_update_us(a);
+      px    += g_flush_stats.px_rendered;
+      rects += g_flush_stats.flushes;
+    }
+
+    Serial.printf("[port] %-7s UI%d int=%lu B psram=%lu B (vrij %lu) full=%lu us update=%lu us px=%lu flushes=%lu\n",
+                  direct ? "direct" : "partial", ui + 1,
+                  (unsigned long)int_bytes, (unsigned long)ps_bytes, (unsigned long)ps_free,
+                  (unsigned long)(full / REPS), (unsigned long)(upd / REPS),
+                  (unsigned long)(px / REPS), (unsigned long)(rects / REPS));
+  }
+}
+
+// Draw-buffers doorlopen: buftune::LINES x 1/2 buffers x intern/PSRAM. Per
+// configuratie hetzelfde script (per scherm: tonen + volledig frame, dan TICKS
+// model-ticks vanaf hetzelfde model); tabel en aanbevolen build-vlaggen.
+static void benchmark_draw_bufs() {
+  constexpr int TICKS = 5;
+  static buftune::Config cfgs[buftune::CONFIG_COUNT];
+  static buftune::Result res[buftune::CONFIG_COUNT];
+  const int n = buftune::configs(cfgs);
+  const DisplayModel start = g_model;
+
+  Serial.println("[buf] lines bufs mem    int B  psram B  frame us flushes");
+  for (int i = 0; i < n; i++) {
+    const buftune::Config& c = cfgs[i];
+    buftune::Result& r = res[i];
+    r = { c, false, 0, 0 };
+
+    // Eerst naar de kleinste: de nieuwe buffers moeten naast de oude passen
+    lvgl_port_set_mode(PortMode::PARTIAL, cfgs[0]);
+    if (!lvgl_port_set_mode(PortMode::PARTIAL, c)) {
+      Serial.printf("[buf] %5u %4u %-6s geen geheugen\n", c.lines, c.buffers, c.psram ? "psram" : "intern");
+      continue;
+    }
+
+    g_model = start;
+    uint32_t us = 0, flushes = 0, frames = 0;
+    for (int ui = 0; ui < 3; ui++) {
+      const ActiveUI a = static_cast<ActiveUI>(ui);
+      ui_show(a);
+      us += bench_refresh_us();
+      flushes += g_flush_stats.flushes;
+      frames++;
+      for (int t = 0; t < TICKS; t++) {
+        us += bench_update_us(a);
+        flushes += g_flush_stats.flushes;
+        frames++;
+      }
+    }
+    r.ok       = true;
+    r.frame_us = us / frames;
+    r.flushes  = flushes / frames;
+
+    uint32_t int_bytes, ps_bytes;
+    port_ram(int_bytes, ps_bytes);
+    Serial.printf("[buf] %5u %4u %-6s %7lu %8lu %9lu %7lu\n", c.lines, c.buffers,
+                  c.psram ? "psram" : "intern", (unsigned long)int_bytes, (unsigned long)ps_bytes,
+                  (unsigned long)r.frame_us, (unsigned long)r.flushes);
+  }
+
+  const int best = buftune::recommend(res, n, LCD_W);
+  if (best >= 0) {
+    const buftune::Result& r = res[best];
+    Serial.printf("[buf] aanbevolen: -DDISPLAY_DRAW_BUF_LINES=%u -DDISPLAY_DRAW_BUF_COUNT=%u "
+                  "-DDISPLAY_DRAW_BUF_PSRAM=%d (%lu us/frame, %lu B)\n",
+                  r.cfg.lines, r.cfg.buffers, r.cfg.psram ? 1 : 0, (unsigned long)r.frame_us,
+                  (unsigned long)buftune::ram_bytes(r.cfg, LCD_W));
+  }
+  g_model = start;
+}
+
+// Volledige UI1-render per aantal tegels. Met -DDISPLAY_DUAL_CORE=1 zijn er twee
+// draw units: tiles=1 laat in de praktijk één core renderen, tiles=2 beide. Een
+// build zonder de vlag (LVGL zonder OS, één unit) is de single-core referentie.
+static void benchmark_render() {
+  constexpr int REPS = 10;
+  ui_show(ActiveUI::UI1);
+
+  for (uint32_t tiles = 1; tiles <= LV_DRAW_SW_DRAW_UNIT_CNT; tiles++) {
+    lv_display_set_tile_cnt(disp, tiles);
+    bench_refresh_us();   // eerste keer niet meetellen
+    uint32_t frame = 0, render = 0;
+    for (int r = 0; r < REPS; r++) {
+      frame  += bench_refresh_us();
+      render += g_flush_stats.render_us;
+    }
+    Serial.printf("[mc] units=%d tiles=%lu ui1 render=%lu us frame=%lu us\n",
+                  LV_DRAW_SW_DRAW_UNIT_CNT, (unsigned long)tiles,
+                  (unsigned long)(render / REPS), (unsigned long)(frame / REPS));
+  }
+  lv_display_set_tile_cnt(disp, LV_DRAW_SW_DRAW_UNIT_CNT);
+}
+
+static void display_benchmark() {
+  const DisplayBackend& standard = display_backend();
+  benchmark_backend(backend_ili9488);
+  benchmark_backend(backend_lgfx);
+  display_backend_select(standard);
+
+  benchmark_switch(false);
+  benchmark_switch(true);
+
+  benchmark_styles(false);
+  benchmark_styles(true);
+
+  benchmark_render();
+
+  benchmark_port_mode(PortMode::PARTIAL);
+  benchmark_port_mode(PortMode::DIRECT);
+
+  benchmark_draw_bufs();
+  lvgl_port_set_default();
+}
+#endif
+
 void display_task(void* pvParameters) {
   Serial.println("Display task gestart");
 
+  g_boot.task_start_ms = millis();
+
+  // Paneel-init loopt op de achtergrond: de verplichte wachttijden (SWRESET,
+  // SLPOUT) overlappen met backlight, lv_init en het opbouwen van de UI
+  const DisplayBackend& backend = display_backend();
+  backend.init_begin();
+
   backlight_init_and_on();
-  ili9488_init();
+  backend.init_poll();
 
   lv_init();
+#if DISPLAY_DEADLINE_LOOP
+  // Tick loopt niet meer achter als een frame langer duurt dan de lus
+  lv_tick_set_cb(lv_tick_ms);
+#endif
+  backend.init_poll();
   lvgl_port_init();
+  backend.init_poll();
+
+  demo_model_init(g_model);
 
-  model_init(g_model);
+  // Alle schermen nu opbouwen (overlapt met de paneel-init); daarna alleen nog wisselen
+  ui_screens_set_transition(UI_SWITCH_ANIM_MS);
+  ui_screens_create();
+  backend.init_poll();
 
   // Start met UI1
   current_ui = ActiveUI::UI1;
-  ui1_create();
-  ui1_update(g_model);
+  ui_show(current_ui);
+
+  // Voor de eerste flush moet het paneel klaar zijn
+  const uint32_t t_block = millis();
+  while (!backend.init_poll()) delay(1);
+  g_boot.panel_ready_ms = millis();
+  g_boot.init_block_ms  = g_boot.panel_ready_ms - t_block;
+
+#if DISPLAY_STRIP_CHART
+  strip_begin();
+#endif
+
+#if DISPLAY_BENCHMARK
+  display_benchmark();
+  ui_show(current_ui);
+#endif
 
   uint32_t last_update = millis();
   uint32_t last_switch = millis();
 
   while (true) {
+    g_loop.wakeups++;
+
     // LVGL tick + timers
+#if !DISPLAY_DEADLINE_LOOP
     lv_tick_inc(5);
-    lv_timer_handler();
+#endif
+    const uint32_t t_timer = micros();
+    g_refr_seen = false;
+    uint32_t timer_wait_ms = lv_timer_handler();
+    if (g_refr_seen) g_frame_timer_us = micros() - t_timer;
+    flush_stats_report();
+    boot_report();
 
     const uint32_t now = millis();
 
     // Elke seconde: model + UI updaten
     if (now - last_update >= 1000) {
+      if (DISPLAY_STATS) loop_report(now - last_update);
+      g_loop.wakeups = 0;
       last_update = now;
 
-      model_tick_1s(g_model);
+      demo_model_tick_1s(g_model);
+      uibind::stats() = {};
+      g_inv_px = 0;
 
+      // Widgets alleen onder de LVGL-lock aanpassen: lv_timer_handler neemt hem zelf,
+      // andere taken (input, een tweede UI-bron) kunnen zo veilig meedoen. Zonder OS
+      // (DISPLAY_DUAL_CORE=0) is dit een no-op.
+      lv_lock();
       switch (current_ui) {
-        case ActiveUI::UI1: ui1_update(g_model); break;
+        case ActiveUI::UI1:
+          ui1_update(g_model);
+#if DISPLAY_STRIP_CHART
+          strip_sample(g_model);
+#endif
+          break;
         case ActiveUI::UI2: ui2_update(g_model); break;
         case ActiveUI::UI3: ui3_update(g_model); break;
       }
+#if DISPLAY_DEADLINE_LOOP
+      // Niet wachten op de volgende refr-periode: meteen renderen
+      lv_timer_ready(lv_display_get_refr_timer(disp));
+      timer_wait_ms = 0;
+#endif
+      lv_unlock();
+      g_loop.update_us = micros();
+      g_loop.update_pending = true;
+      if (DISPLAY_STATS) bind_report(current_ui);
     }
 
     // Elke UI_SWITCH_INTERVAL_MS ms: UI wisselen
     if (now - last_switch >= UI_SWITCH_INTERVAL_MS) {
       last_switch = now;
 
+      if (DISPLAY_STATS) fill_stats_report(current_ui);
+#if DISPLAY_STRIP_CHART
+      strip_end();
+#endif
       current_ui = static_cast<ActiveUI>((static_cast<uint8_t>(current_ui) + 1) % 3);
 
-      switch (current_ui) {
-        case ActiveUI::UI1: ui1_create(); ui1_update(g_model); break;
-        case ActiveUI::UI2: ui2_create(); ui2_update(g_model); break;
-        case ActiveUI::UI3: ui3_create(); ui3_update(g_model); break;
-      }
+      const uint32_t us = ui_switch_us(current_ui);
+      if (DISPLAY_STATS) mem_report(current_ui == ActiveUI::UI1 ? "UI1" : current_ui == ActiveUI::UI2 ? "UI2" : "UI3", us);
+#if DISPLAY_STRIP_CHART
+      if (current_ui == ActiveUI::UI1) strip_begin();
+#endif
     }
 
+#if DISPLAY_DEADLINE_LOOP
+    // Slapen tot de vroegste deadline; LV_NO_TIMER_READY valt hier vanzelf weg
+    const uint32_t t = millis();
+    uint32_t wait_ms = timer_wait_ms;
+    if (ms_until(last_update, 1000, t) < wait_ms) wait_ms = ms_until(last_update, 1000, t);
+    if (ms_until(last_switch, UI_SWITCH_INTERVAL_MS, t) < wait_ms) wait_ms = ms_until(last_switch, UI_SWITCH_INTERVAL_MS, t);
+    vTaskDelay(pdMS_TO_TICKS(wait_ms));
+#else
+    (void)timer_wait_ms;
     vTaskDelay(pdMS_TO_TICKS(5));
+#endif
   }
-} 
\ No newline at end of file
+}
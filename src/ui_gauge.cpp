@@ -0,0 +1,148 @@
+// ui_gauge.cpp - ringmeter met voorgerasterde ring (zie ui_gauge.hpp)
+#include "ui_gauge.hpp"
+#include <stdlib.h>
+#include "arc_gauge.hpp"
+
+#ifdef ESP_PLATFORM
+#include <esp_heap_caps.h>
+#endif
+
+// Beeldbuffers zijn size^2 bytes (180x180: 32 KB): liefst in PSRAM, anders gewone heap
+static void* gauge_alloc(size_t n)
+{
+#ifdef ESP_PLATFORM
+    void* p = heap_caps_malloc(n, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (p) return p;
+#endif
+    return malloc(n);
+}
+
+// Gedeelde ringen: UI2 en UI3 gebruiken dezelfde maat, dus in de praktijk één
+static constexpr int UI_GAUGE_RINGS = 2;
+static arcgauge::Ring ui_gauge_rings[UI_GAUGE_RINGS];
+
+static const arcgauge::Ring* ui_gauge_ring(uint16_t size, uint16_t width, uint16_t rotation, uint16_t steps)
+{
+    for (arcgauge::Ring& r : ui_gauge_rings) {
+        if (r.coverage && r.size == size && r.width == width &&
+            r.rotation == rotation % 360 && r.steps == steps) {
+            return &r;
+        }
+    }
+    for (arcgauge::Ring& r : ui_gauge_rings) {
+        if (!r.coverage) return r.init(size, width, rotation, steps, gauge_alloc) ? &r : nullptr;
+    }
+    return nullptr;
+}
+
+struct UiGauge {
+    arcgauge::Gauge g;
+    lv_image_dsc_t  ring_img;
+    lv_image_dsc_t  ind_img;
+    lv_color_t      ring_color;
+    lv_color_t      ind_color;
+};
+
+static void a8_image(lv_image_dsc_t& img, const uint8_t* data, uint16_t size)
+{
+    img = {};
+    img.header.magic  = LV_IMAGE_HEADER_MAGIC;
+    img.header.cf     = LV_COLOR_FORMAT_A8;
+    img.header.w      = size;
+    img.header.h      = size;
+    img.header.stride = size;
+    img.data_size     = (uint32_t)size * size;
+    img.data          = data;
+}
+
+// Twee A8-blits met recolor: de vaste ring, daarover de indicator. LVGL knipt
+// zelf op het te verversen gebied, dus een kleine update blit ook maar een klein stuk.
+static void ui_gauge_draw_cb(lv_event_t* e)
+{
+    lv_obj_t* obj = lv_event_get_current_target_obj(e);
+    const UiGauge* st = (const UiGauge*)lv_obj_get_user_data(obj);
+    if (!st) return;
+
+    lv_area_t a;
+    lv_obj_get_coords(obj, &a);
+    a.x2 = a.x1 + st->ring_img.header.w - 1;
+    a.y2 = a.y1 + st->ring_img.header.h - 1;
+
+    lv_layer_t* layer = lv_event_get_layer(e);
+    lv_draw_image_dsc_t d;
+    lv_draw_image_dsc_init(&d);
+    d.recolor_opa = LV_OPA_COVER;
+
+    d.src     = &st->ring_img;
+    d.recolor = st->ring_color;
+    lv_draw_image(layer, &d, &a);
+
+    if (st->g.value > 0) {
+        d.src     = &st->ind_img;
+        d.recolor = st->ind_color;
+        lv_draw_image(layer, &d, &a);
+    }
+}
+
+static void ui_gauge_delete_cb(lv_event_t* e)
+{
+    lv_obj_t* obj = lv_event_get_current_target_obj(e);
+    UiGauge* st = (UiGauge*)lv_obj_get_user_data(obj);
+    if (!st) return;
+    lv_image_cache_drop(&st->ind_img);
+    st->g.release();
+    lv_free(st);
+    lv_obj_set_user_data(obj, nullptr);
+}
+
+lv_obj_t* ui_gauge_create(lv_obj_t* parent, uint16_t size, uint16_t width, uint16_t rotation,
+                          uint16_t steps, lv_color_t ring_color, lv_color_t indicator_color)
+{
+    lv_obj_t* obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, size, size);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+
+    const arcgauge::Ring* ring = ui_gauge_ring(size, width, rotation, steps);
+    UiGauge* st = ring ? (UiGauge*)lv_malloc_zeroed(sizeof(UiGauge)) : nullptr;
+    if (!st) return obj;
+    if (!st->g.init(*ring, gauge_alloc)) {
+        lv_free(st);
+        return obj;
+    }
+
+    a8_image(st->ring_img, ring->coverage, size);
+    a8_image(st->ind_img, st->g.indicator, size);
+    st->ring_color = ring_color;
+    st->ind_color  = indicator_color;
+
+    lv_obj_set_user_data(obj, st);
+    lv_obj_add_event_cb(obj, ui_gauge_draw_cb, LV_EVENT_DRAW_MAIN, nullptr);
+    lv_obj_add_event_cb(obj, ui_gauge_delete_cb, LV_EVENT_DELETE, nullptr);
+    return obj;
+}
+
+void ui_gauge_set_value(lv_obj_t* gauge, int32_t value)
+{
+    UiGauge* st = (UiGauge*)lv_obj_get_user_data(gauge);
+    if (!st) return;
+
+    arcgauge::Rect dirty[arcgauge::Gauge::MAX_DIRTY];
+    const int n = st->g.set((int)value, dirty);
+    if (n == 0) return;
+
+    // De indicator-pixels zijn in place gewijzigd; pas van belang als LV_CACHE_DEF_SIZE > 0
+    lv_image_cache_drop(&st->ind_img);
+
+    lv_area_t c;
+    lv_obj_get_coords(gauge, &c);
+    for (int i = 0; i < n; i++) {
+        lv_area_t a;
+        a.x1 = c.x1 + dirty[i].x1;
+        a.y1 = c.y1 + dirty[i].y1;
+        a.x2 = c.x1 + dirty[i].x2;
+        a.y2 = c.y1 + dirty[i].y2;
+        lv_obj_invalidate_area(gauge, &a);
+    }
+}
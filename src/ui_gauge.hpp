@@ -0,0 +1,14 @@
+// ui_gauge.hpp - ringmeter met voorgerasterde ring (lichtere variant van lv_arc voor UI2/UI3)
+#pragma once
+#include <stdint.h>
+#include <lvgl.h>
+
+// Volledige ring van size x size en dikte `width`, waarde 0..steps met de klok mee
+// vanaf `rotation` (graden zoals lv_arc_set_rotation). De ring wordt één keer als
+// A8-beeld gerasterd en gedeeld door gauges van dezelfde maat; een waardewijziging
+// schrijft en invalideert alleen de stappen tussen oude en nieuwe waarde.
+// Ronde uiteinden zoals lv_arc met arc_rounded. Faalt de allocatie, dan tekent het object niets.
+lv_obj_t* ui_gauge_create(lv_obj_t* parent, uint16_t size, uint16_t width, uint16_t rotation,
+                          uint16_t steps, lv_color_t ring_color, lv_color_t indicator_color);
+
+void ui_gauge_set_value(lv_obj_t* gauge, int32_t value);
@@ -2,26 +2,112 @@
 #include "ui_screens.hpp"
 #include <Arduino.h>
 #include <lvgl.h>
+#include "ui_bind.hpp"
+#include "ui_fmt.hpp"
+#include "curve_decim.hpp"
+#include "ui_gauge.hpp"
+#include "ui_theme.hpp"
+
+// ---------- Binding model -> widgets ----------
+// ui*_update zet alleen widgets waarvan de getoonde (gekwantiseerde) waarde
+// verandert; elke lv_label_set_text invalideert anders opnieuw het label.
+
+static void set_centi(uibind::Field& f, lv_obj_t* label, float v,
+                      const char* pre, const char* post) {
+  if (!label || !f.set(uibind::quantize(v, 100))) return;
+  char buf[48];
+  uifmt::Writer(buf, sizeof(buf)).str(pre).fixed(f.shown, 2, 2).str(post);
+  lv_label_set_text(label, buf);
+}
+
+// ---------- Schermbeheer ----------
+// Elke UI heeft een eigen lv_obj-scherm dat één keer wordt opgebouwd; wisselen is
+// daarna alleen lv_screen_load. Zonder persistent (oude gedrag, voor metingen)
+// wordt het actieve scherm leeggemaakt en bij elke wissel opnieuw opgebouwd.
+static lv_obj_t* ui_scr[3]      = {};
+static bool      ui_persistent  = true;
+static uint32_t  ui_anim_ms     = 0;
+
+// Scherm waarop UI `i` gebouwd wordt
+static lv_obj_t* ui_screen_begin(int i) {
+  if (ui_persistent) {
+    ui_scr[i] = lv_obj_create(nullptr);
+    return ui_scr[i];
+  }
+
+  lv_obj_t* scr = lv_screen_active();
+  lv_obj_clean(scr);
+  for (auto& s : ui_scr) {
+    if (s == scr) s = nullptr;   // objecten van die UI zijn nu weg
+  }
+  ui_scr[i] = scr;
+  return scr;
+}
+
+static bool ui_built(int i) {
+  return ui_persistent && ui_scr[i] != nullptr;
+}
+
+static void ui_show(int i, void (*create)()) {
+  if (!ui_built(i)) create();
+  if (ui_scr[i] == lv_screen_active()) return;
+
+  if (ui_anim_ms > 0) {
+    lv_screen_load_anim(ui_scr[i], LV_SCREEN_LOAD_ANIM_FADE_IN, ui_anim_ms, 0, false);
+  } else {
+    lv_screen_load(ui_scr[i]);
+  }
+}
+
+void ui_screens_create() {
+  ui1_create();
+  ui2_create();
+  ui3_create();
+}
+
+void ui_screens_reset() {
+  lv_obj_t* act = lv_screen_active();
+  for (auto* s : ui_scr) {
+    if (s == act) {
+      lv_screen_load(lv_obj_create(nullptr));   // actief scherm mag niet weg
+      break;
+    }
+  }
+  for (auto& s : ui_scr) {
+    if (s) lv_obj_delete(s);
+    s = nullptr;
+  }
+}
+
+void ui_screens_set_persistent(bool on) {
+  if (on == ui_persistent) return;
+  ui_screens_reset();
+  ui_persistent = on;
+}
+
+void ui_screens_set_transition(uint32_t ms) {
+  ui_anim_ms = ms;
+}
 
-// --- UI color palette ---
-#define UI_COL_BG              0x000000   // global background
-#define UI_COL_TEXT            0xEDBE0E   // main text (yellow)
-#define UI_COL_CHART_BG        0x000000   // chart background
-#define UI_COL_CHART_BORDER    0xEDBE0E   // chart border
-#define UI_COL_CHART_SERIES    0xEDBE0E   // discharge curve
-#define UI_COL_CHART_LINE      0xEDBE0E   // helper line in chart
-#define UI_COL_AXIS_TEXT       0xEDBE0E   // axis labels
-#define UI_COL_MEAS_TEXT       0xEDBE0E   // measurement & curve info text
-#define UI_COL_SIDEBAR_BG      0xEDBE0E   // sidebar background
-#define UI_COL_SIDEBAR_BORDER  0x000000   // sidebar border lines
-#define UI_COL_BUTTON_BG       0xEDBE0E   // button background (yellow)
-#define UI_COL_BUTTON_BORDER   0x000000   // button border
-#define UI_COL_BUTTON_TEXT     0x000000   // button text
-#define UI_COL_UI2_BG          0x000000   // background for UI2
-#define UI_COL_UI2_TEXT        0xEDBE0E   // UI2 text
+void ui1_show() { ui_show(0, ui1_create); }
+void ui2_show() { ui_show(1, ui2_create); }
+void ui3_show() { ui_show(2, ui3_create); }
 
 // ---------- UI1: Emulate / laadcurve-scherm ----------
 
+// chart-geometrie (ook gebruikt door de strip-chart in display_thread)
+static constexpr int UI1_CHART_X = 30;
+static constexpr int UI1_CHART_Y = 25;
+static constexpr int UI1_CHART_W = 310;
+static constexpr int UI1_CHART_H = 180;
+
+void ui1_chart_area(int& x, int& y, int& w, int& h) {
+  x = UI1_CHART_X;
+  y = UI1_CHART_Y;
+  w = UI1_CHART_W;
+  h = UI1_CHART_H;
+}
+
 // pointers bewaren voor later gebruik / updates
 static lv_obj_t* ui1_chart             = nullptr;
 static lv_chart_series_t* ui1_series   = nullptr;
@@ -48,27 +134,91 @@ static lv_obj_t* ui1_lbl_btn_nominal_v = nullptr;
 static lv_obj_t* ui1_lbl_btn_capacity  = nullptr;
 
 // lijn in de grafiek
-static lv_obj_t* ui1_progress_line     = nullptr;
-static lv_point_precise_t ui1_progress_pts[2];
+// Cursor-overlay: geen eigen object maar getekend in de DRAW_POST van de chart.
+// Coördinaten relatief aan het content-gebied van de chart; bij verplaatsen
+// worden alleen de oude en nieuwe kolom geïnvalideerd.
+static constexpr int UI1_CURSOR_W     = 2;
+static constexpr int UI1_CURSOR_DASH  = 6;
+static constexpr int UI1_CURSOR_GAP   = 4;
+
+static struct {
+  bool    visible;
+  int32_t x;         // kolom
+  int32_t y_top;     // curvewaarde
+  int32_t y_bottom;  // net boven de onderrand
+} ui1_cursor;
+
+// laatst getoonde waarden
+// gedecimeerde curve: min/max per pixelkolom, tevens de seriebuffer van de chart
+static curvedecim::Cache<UI1_CHART_W> ui1_curve;
+
+static struct {
+  uibind::Field curve;       // op ui1_curve.recomputes
+  uibind::Field progress;
+  uibind::Field v_meas, i_meas, runtime, capacity, state;
+  uibind::Field btn_nominal_v, btn_capacity;
+} ui1_bind;
+
+// Schermgebied dat de cursor beslaat: de lijnbreedte plus één kolom anti-aliasing
+static void ui1_cursor_area(lv_area_t& a)
+{
+    lv_area_t c;
+    lv_obj_get_content_coords(ui1_chart, &c);
+    a.x1 = c.x1 + ui1_cursor.x - UI1_CURSOR_W / 2;
+    a.x2 = c.x1 + ui1_cursor.x + UI1_CURSOR_W / 2;
+    a.y1 = c.y1 + ui1_cursor.y_top - UI1_CURSOR_W / 2;
+    a.y2 = c.y1 + ui1_cursor.y_bottom + UI1_CURSOR_W / 2;
+}
 
-// helper: verticale lijnpositie updaten op basis van model.ui1.progress_index + curve
-static void ui1_update_progress_line(const DisplayModel& m)
+static void ui1_cursor_invalidate()
 {
-    if (!ui1_chart || !ui1_progress_line) return;
+    if (!ui1_cursor.visible) return;
+    lv_area_t a;
+    ui1_cursor_area(a);
+    lv_obj_invalidate_area(ui1_chart, &a);
+}
 
-    const int point_count = m.ui1.curve_len;
-    if (point_count <= 1) return;
+// Na de chart (en de serie) tekenen; LVGL heeft de clip al op het dirty-gebied gezet
+static void ui1_cursor_draw_cb(lv_event_t* e)
+{
+    if (!ui1_cursor.visible) return;
+
+    lv_area_t c;
+    lv_obj_get_content_coords(ui1_chart, &c);
+
+    lv_draw_line_dsc_t d;
+    lv_draw_line_dsc_init(&d);
+    d.color      = lv_color_hex(UI_COL_CHART_LINE);
+    d.width      = UI1_CURSOR_W;
+    d.dash_width = UI1_CURSOR_DASH;
+    d.dash_gap   = UI1_CURSOR_GAP;
+    d.p1.x = c.x1 + ui1_cursor.x;
+    d.p1.y = c.y1 + ui1_cursor.y_bottom;
+    d.p2.x = c.x1 + ui1_cursor.x;
+    d.p2.y = c.y1 + ui1_cursor.y_top;
+    lv_draw_line(lv_event_get_layer(e), &d);
+}
+
+// helper: cursorpositie updaten op basis van model.ui1.progress_index + curve
+static void ui1_update_cursor(const DisplayModel& m)
+{
+    if (!ui1_chart) return;
+
+    // Zichtbaar deel van de curve (zoom), zoals de cache het geclampt heeft
+    const int first       = (int)ui1_curve.first;
+    const int point_count = (int)ui1_curve.count;
+    if (!m.ui1.curve || point_count <= 1) return;
 
     int idx = m.ui1.progress_index;
-    if (idx < 0) idx = 0;
-    if (idx > point_count - 1) idx = point_count - 1;
+    if (idx < first) idx = first;
+    if (idx > first + point_count - 1) idx = first + point_count - 1;
 
     int graph_width  = lv_obj_get_width(ui1_chart);
     int graph_height = lv_obj_get_height(ui1_chart);
     if (graph_width <= 1 || graph_height <= 1) return;
 
-    // X-positie over de breedte van de chart
-    int x = (graph_width - 1) * idx / (point_count - 1);
+    // X-positie over de breedte van de chart (kolommen zijn gelijk verdeeld over de bron)
+    int x = (int)((int64_t)(graph_width - 1) * (idx - first) / (point_count - 1));
 
     // Waarde (0..100) uit de curve
     int16_t v = m.ui1.curve[idx];
@@ -77,33 +227,30 @@ static void ui1_update_progress_line(const DisplayModel& m)
     int y_curve = (graph_height - 1) - (graph_height - 1) * v / 100;
 
     // Lijn van onderkant chart tot aan de curve
-    ui1_progress_pts[0].x = x;
-    ui1_progress_pts[0].y = graph_height - 2;   // net boven onderste rand
-    ui1_progress_pts[1].x = x;
-    ui1_progress_pts[1].y = y_curve;
-
-    lv_line_set_points(ui1_progress_line, ui1_progress_pts, 2);
+    ui1_cursor_invalidate();   // oude kolom
+    ui1_cursor.visible  = true;
+    ui1_cursor.x        = x;
+    ui1_cursor.y_top    = y_curve;
+    ui1_cursor.y_bottom = graph_height - 2;   // net boven onderste rand
+    ui1_cursor_invalidate();   // nieuwe kolom
 }
 
 void ui1_create() {
-  lv_obj_t* scr = lv_screen_active();
-  lv_obj_clean(scr);
+  if (ui_built(0)) return;
+  lv_obj_t* scr = ui_screen_begin(0);
+  ui1_bind = {};
 
   // -------- achtergrond / hoofdvlak --------
-  lv_obj_set_style_bg_color(scr, lv_color_hex(UI_COL_BG), LV_PART_MAIN);
-  lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, LV_PART_MAIN);
+  ui_theme_apply(scr, UI_STYLE_SCREEN);
 
   // Titel bovenaan
-  lv_obj_t* title = lv_label_create(scr);
-  lv_label_set_text(title, "Emulate");
-  lv_obj_set_style_text_color(title, lv_color_hex(UI_COL_TEXT), 0);
-  lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 5);
+  ui_theme_label(scr, "Emulate", UI_STYLE_TITLE);
 
   // -------- linker inhoudsgebied (grafiek + info) --------
-  const int left_margin   = 30;
-  const int top_margin    = 25;
-  const int graph_width   = 310;
-  const int graph_height  = 180;
+  const int left_margin   = UI1_CHART_X;
+  const int top_margin    = UI1_CHART_Y;
+  const int graph_width   = UI1_CHART_W;
+  const int graph_height  = UI1_CHART_H;
 
   ui1_chart = lv_chart_create(scr);
   lv_obj_set_size(ui1_chart, graph_width, graph_height);
@@ -116,36 +263,27 @@ void ui1_create() {
   lv_chart_set_range(ui1_chart, LV_CHART_AXIS_PRIMARY_Y, 0, 100);
   lv_chart_set_point_count(ui1_chart, 32);
 
-  lv_obj_set_style_bg_color(ui1_chart, lv_color_hex(UI_COL_CHART_BG), LV_PART_MAIN);
-  lv_obj_set_style_border_color(ui1_chart, lv_color_hex(UI_COL_CHART_BORDER), LV_PART_MAIN);
-  lv_obj_set_style_border_width(ui1_chart, 1, LV_PART_MAIN);
+  ui_theme_apply(ui1_chart, UI_STYLE_CHART);
 
-  // Discharge-curve data (wordt gezet in ui1_update op basis van model)
+  // Discharge-curve data (wordt gezet in ui1_update op basis van model). De serie
+  // leest rechtstreeks uit de decimatie-cache: geen kopie in de LVGL-pool.
   ui1_series = lv_chart_add_series(ui1_chart,
                                    lv_color_hex(UI_COL_CHART_SERIES),
                                    LV_CHART_AXIS_PRIMARY_Y);
 
-  for (int i = 0; i < 32; ++i) {
-    lv_chart_set_value_by_id(ui1_chart, ui1_series, i, 0);
-  }
+  ui1_curve.reset();
+  lv_chart_set_series_ext_y_array(ui1_chart, ui1_series, ui1_curve.points);
   lv_chart_refresh(ui1_chart);
 
-  // Verticale “cursor”-lijn
-  ui1_progress_line = lv_line_create(ui1_chart);
-  lv_obj_set_style_line_color(ui1_progress_line, lv_color_hex(UI_COL_CHART_LINE), 0);
-  lv_obj_set_style_line_width(ui1_progress_line, 2, 0);
-  lv_obj_set_style_line_dash_width(ui1_progress_line, 6, 0);
-  lv_obj_set_style_line_dash_gap(ui1_progress_line, 4, 0);
+  // Verticale “cursor”-lijn: overlay, zie ui1_cursor_draw_cb
+  ui1_cursor.visible = false;
+  lv_obj_add_event_cb(ui1_chart, ui1_cursor_draw_cb, LV_EVENT_DRAW_POST, nullptr);
 
   // As-labels
-  lv_obj_t* lbl_x = lv_label_create(scr);
-  lv_label_set_text(lbl_x, "Capacity ->");
-  lv_obj_set_style_text_color(lbl_x, lv_color_hex(UI_COL_AXIS_TEXT), 0);
+  lv_obj_t* lbl_x = ui_theme_label(scr, "Capacity ->", UI_STYLE_AXIS_TEXT);
   lv_obj_align(lbl_x, LV_ALIGN_TOP_LEFT, left_margin + 60, top_margin + graph_height + 5);
 
-  lv_obj_t* lbl_y = lv_label_create(scr);
-  lv_label_set_text(lbl_y, "Voltage ->");
-  lv_obj_set_style_text_color(lbl_y, lv_color_hex(UI_COL_AXIS_TEXT), 0);
+  lv_obj_t* lbl_y = ui_theme_label(scr, "Voltage ->", UI_STYLE_AXIS_TEXT);
   lv_obj_align(lbl_y, LV_ALIGN_TOP_LEFT, left_margin - 20, top_margin + graph_height/2 + 30);
   lv_obj_set_style_transform_angle(lbl_y, 2700, 0); // 90 graden roteren
 
@@ -153,93 +291,36 @@ void ui1_create() {
   const int bottom_y = top_margin + graph_height + 35;
 
   // Measurements block (links)
-  ui1_label_meas_title = lv_label_create(scr);
-  lv_label_set_text(ui1_label_meas_title, "Measurements:");
-  lv_obj_set_style_text_color(ui1_label_meas_title, lv_color_hex(UI_COL_MEAS_TEXT), 0);
+  ui1_label_meas_title = ui_theme_label(scr, "Measurements:", UI_STYLE_MEAS_TEXT);
   lv_obj_align(ui1_label_meas_title, LV_ALIGN_TOP_LEFT, left_margin, bottom_y - 8);
 
-  ui1_label_v_meas = lv_label_create(scr);
-  lv_label_set_text(ui1_label_v_meas, "Voltage = 0.00 V");
-  lv_obj_set_style_text_color(ui1_label_v_meas, lv_color_hex(UI_COL_MEAS_TEXT), 0);
+  ui1_label_v_meas = ui_theme_label(scr, "Voltage = 0.00 V", UI_STYLE_MEAS_TEXT);
   lv_obj_align_to(ui1_label_v_meas, ui1_label_meas_title, LV_ALIGN_OUT_BOTTOM_LEFT, 0, 5);
 
-  ui1_label_i_meas = lv_label_create(scr);
-  lv_label_set_text(ui1_label_i_meas, "Ampere = 0.00 A");
-  lv_obj_set_style_text_color(ui1_label_i_meas, lv_color_hex(UI_COL_MEAS_TEXT), 0);
+  ui1_label_i_meas = ui_theme_label(scr, "Ampere = 0.00 A", UI_STYLE_MEAS_TEXT);
   lv_obj_align_to(ui1_label_i_meas, ui1_label_v_meas, LV_ALIGN_OUT_BOTTOM_LEFT, 0, 5);
 
   // Curve-info block (rechts van measurements)
-  ui1_label_curve_title = lv_label_create(scr);
-  lv_label_set_text(ui1_label_curve_title, "Curve:");
-  lv_obj_set_style_text_color(ui1_label_curve_title, lv_color_hex(UI_COL_MEAS_TEXT), 0);
+  ui1_label_curve_title = ui_theme_label(scr, "Curve:", UI_STYLE_MEAS_TEXT);
   lv_obj_align(ui1_label_curve_title, LV_ALIGN_TOP_LEFT, left_margin + 150, bottom_y - 8);
 
-  ui1_label_runtime = lv_label_create(scr);
-  lv_label_set_text(ui1_label_runtime, "Run-time = 00:00");
-  lv_obj_set_style_text_color(ui1_label_runtime, lv_color_hex(UI_COL_MEAS_TEXT), 0);
+  ui1_label_runtime = ui_theme_label(scr, "Run-time = 00:00", UI_STYLE_MEAS_TEXT);
   lv_obj_align_to(ui1_label_runtime, ui1_label_curve_title, LV_ALIGN_OUT_BOTTOM_LEFT, 0, 5);
 
-  ui1_label_capacity = lv_label_create(scr);
-  lv_label_set_text(ui1_label_capacity, "Capacity = 0.00 F");
-  lv_obj_set_style_text_color(ui1_label_capacity, lv_color_hex(UI_COL_MEAS_TEXT), 0);
+  ui1_label_capacity = ui_theme_label(scr, "Capacity = 0.00 F", UI_STYLE_MEAS_TEXT);
   lv_obj_align_to(ui1_label_capacity, ui1_label_runtime, LV_ALIGN_OUT_BOTTOM_LEFT, 0, 5);
 
-  ui1_label_state = lv_label_create(scr);
-  lv_label_set_text(ui1_label_state, "Current state = load/unload");
-  lv_obj_set_style_text_color(ui1_label_state, lv_color_hex(UI_COL_MEAS_TEXT), 0);
+  ui1_label_state = ui_theme_label(scr, "Current state = load/unload", UI_STYLE_MEAS_TEXT);
   lv_obj_align_to(ui1_label_state, ui1_label_capacity, LV_ALIGN_OUT_BOTTOM_LEFT, 0, 5);
 
   // -------- rechter kolom: 5 “knop”-blokken --------
-  lv_obj_t* sidebar = lv_obj_create(scr);
-  lv_obj_set_size(sidebar, 120, 300);
-  lv_obj_align(sidebar, LV_ALIGN_RIGHT_MID, -5, 5);
-  lv_obj_set_style_bg_color(sidebar, lv_color_hex(UI_COL_SIDEBAR_BG), LV_PART_MAIN);
-  lv_obj_set_style_bg_opa(sidebar, LV_OPA_COVER, LV_PART_MAIN);
-  lv_obj_set_style_border_color(sidebar, lv_color_hex(UI_COL_SIDEBAR_BORDER), LV_PART_MAIN);
-  lv_obj_set_style_border_width(sidebar, 1, LV_PART_MAIN);
-  lv_obj_set_style_pad_all(sidebar, 4, LV_PART_MAIN);
-  lv_obj_set_style_pad_gap(sidebar, 4, LV_PART_MAIN);
-  lv_obj_set_flex_flow(sidebar, LV_FLEX_FLOW_COLUMN);
-  lv_obj_set_flex_align(sidebar,
-                        LV_FLEX_ALIGN_START,
-                        LV_FLEX_ALIGN_CENTER,
-                        LV_FLEX_ALIGN_START);
-
-  lv_obj_clear_flag(sidebar, LV_OBJ_FLAG_SCROLLABLE);
-  lv_obj_set_scrollbar_mode(sidebar, LV_SCROLLBAR_MODE_OFF);
-
-  auto make_btn = [&](const char* txt) -> lv_obj_t* {
-    lv_obj_t* btn = lv_btn_create(sidebar);
-
-    // Breedte 100%, hoogte door flex/content bepalen
-    lv_obj_set_width(btn, LV_PCT(100));
-    lv_obj_set_height(btn, LV_SIZE_CONTENT);
-    lv_obj_set_flex_grow(btn, 1); // verdeel hoogte gelijk
-
-    lv_obj_set_style_radius(btn, 0, LV_PART_MAIN);
-    lv_obj_set_style_bg_color(btn, lv_color_hex(UI_COL_BUTTON_BG), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(btn, LV_OPA_COVER, LV_PART_MAIN);
-    lv_obj_set_style_border_color(btn, lv_color_hex(UI_COL_BUTTON_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(btn, 1, LV_PART_MAIN);
-
-    lv_obj_clear_flag(btn, LV_OBJ_FLAG_SCROLLABLE);
-    lv_obj_set_scrollbar_mode(btn, LV_SCROLLBAR_MODE_OFF);
-
-    lv_obj_t* l = lv_label_create(btn);
-    lv_label_set_text(l, txt);
-    lv_obj_center(l);
-
-    lv_obj_set_style_text_font(l, &lv_font_montserrat_12, LV_PART_MAIN);
-    lv_obj_set_style_text_color(l, lv_color_hex(UI_COL_BUTTON_TEXT), 0);
-
-    return btn;
-  };
-
-  ui1_btn_choose_curve = make_btn("Choose Curve");
-  ui1_btn_choose_setp  = make_btn("Choose Setpoint");
-  ui1_btn_nominal_v    = make_btn("Nominal voltage:\n0.00 V");
-  ui1_btn_capacity     = make_btn("Capacity\n0.00 F");
-  ui1_btn_reset        = make_btn("Reset");
+  lv_obj_t* sidebar = ui_theme_sidebar(scr);
+
+  ui1_btn_choose_curve = ui_theme_button(sidebar, "Choose Curve");
+  ui1_btn_choose_setp  = ui_theme_button(sidebar, "Choose Setpoint");
+  ui1_btn_nominal_v    = ui_theme_button(sidebar, "Nominal voltage:\n0.00 V");
+  ui1_btn_capacity     = ui_theme_button(sidebar, "Capacity\n0.00 F");
+  ui1_btn_reset        = ui_theme_button(sidebar, "Reset");
 
   // labels uit de knoppen trekken zodat we ze kunnen updaten
   if (ui1_btn_nominal_v) {
@@ -251,59 +332,54 @@ void ui1_create() {
 }
 
 void ui1_update(const DisplayModel& m) {
-  char buf[64];
 
-  // ---- curve in chart ----
+  // ---- curve in chart: alleen opnieuw decimeren als curve of zoom wijzigt ----
+  bool curve_changed = false;
   if (ui1_chart && ui1_series) {
-    const int n = (m.ui1.curve_len > 32) ? 32 : m.ui1.curve_len;
-    for (int i = 0; i < n; ++i) {
-      lv_chart_set_value_by_id(ui1_chart, ui1_series, i, m.ui1.curve[i]);
-    }
+    ui1_curve.update(m.ui1.curve, m.ui1.curve_len, m.ui1.curve_rev, m.ui1.view_first, m.ui1.view_len);
+    curve_changed = ui1_bind.curve.set((int32_t)ui1_curve.recomputes);
+  }
+  if (curve_changed) {
+    // set_point_count zet alleen de lengte (externe buffer) en doet zelf een refresh
+    const uint32_t n = (ui1_curve.n > 1) ? ui1_curve.n : 2;
+    lv_chart_set_point_count(ui1_chart, n);
     lv_chart_refresh(ui1_chart);
   }
 
   // ---- Measurements ----
-  snprintf(buf, sizeof(buf), "Voltage = %.2f V", m.ui1.voltage_val);
-  if (ui1_label_v_meas) lv_label_set_text(ui1_label_v_meas, buf);
-
-  snprintf(buf, sizeof(buf), "Ampere = %.2f A", m.ui1.current_val);
-  if (ui1_label_i_meas) lv_label_set_text(ui1_label_i_meas, buf);
+  set_centi(ui1_bind.v_meas, ui1_label_v_meas, m.ui1.voltage_val, "Voltage = ", " V");
+  set_centi(ui1_bind.i_meas, ui1_label_i_meas, m.ui1.current_val, "Ampere = ", " A");
 
   // ---- Curve-info: runtime, capacity, state ----
-  uint32_t minutes = m.ui1.runtime_sec / 60;
-  uint32_t seconds = m.ui1.runtime_sec % 60;
-
-  snprintf(buf, sizeof(buf), "Run-time = %02u:%02u", (unsigned)minutes, (unsigned)seconds);
-  if (ui1_label_runtime) lv_label_set_text(ui1_label_runtime, buf);
+  if (ui1_label_runtime && ui1_bind.runtime.set((int32_t)m.ui1.runtime_sec)) {
+    char buf[32];
+    uifmt::Writer(buf, sizeof(buf)).str("Run-time = ").mmss(m.ui1.runtime_sec);
+    lv_label_set_text(ui1_label_runtime, buf);
+  }
 
-  snprintf(buf, sizeof(buf), "Capacity = %.2f F", m.ui1.capacity_val);
-  if (ui1_label_capacity) lv_label_set_text(ui1_label_capacity, buf);
+  set_centi(ui1_bind.capacity, ui1_label_capacity, m.ui1.capacity_val, "Capacity = ", " F");
 
-  if (ui1_label_state) {
+  if (ui1_label_state && ui1_bind.state.set(m.ui1.state_load ? 1 : 0)) {
     lv_label_set_text(ui1_label_state,
                       m.ui1.state_load ? "Current state = load"
                                        : "Current state = unload");
   }
 
-  // ---- Verticale lijn op basis van progress index ----
-  ui1_update_progress_line(m);
-
-  // ---- Buttons: nominal voltage & capacity ----
-  if (ui1_lbl_btn_nominal_v) {
-    snprintf(buf, sizeof(buf), "Nominal voltage:\n%.2f V", m.ui1.nominal_v_val);
-    lv_label_set_text(ui1_lbl_btn_nominal_v, buf);
+  // ---- Verticale lijn: hangt af van de index én de curvewaarde daar ----
+  const bool progress_changed = ui1_bind.progress.set(m.ui1.progress_index);
+  if (progress_changed || curve_changed) {
+    ui1_update_cursor(m);
   }
 
-  if (ui1_lbl_btn_capacity) {
-    snprintf(buf, sizeof(buf), "Capacity\n%.2f F", m.ui1.btn_capacity_val);
-    lv_label_set_text(ui1_lbl_btn_capacity, buf);
-  }
+  // ---- Buttons: nominal voltage & capacity ----
+  set_centi(ui1_bind.btn_nominal_v, ui1_lbl_btn_nominal_v, m.ui1.nominal_v_val, "Nominal voltage:\n", " V");
+  set_centi(ui1_bind.btn_capacity, ui1_lbl_btn_capacity, m.ui1.btn_capacity_val, "Capacity\n", " F");
 }
 
 // ================= UI 2: Constant source (gauge) =================
 
 // UI2 object pointers
-static lv_obj_t* ui2_arc             = nullptr;
+static lv_obj_t* ui2_gauge           = nullptr;
 static lv_obj_t* ui2_label_voltage   = nullptr;
 static lv_obj_t* ui2_label_ampere    = nullptr;
 
@@ -314,125 +390,44 @@ static lv_obj_t* ui2_btn_empty3        = nullptr;
 static lv_obj_t* ui2_btn_empty4        = nullptr;
 static lv_obj_t* ui2_btn_reset         = nullptr;
 
-// helper: maak button met jouw style
-static lv_obj_t* ui2_make_btn(lv_obj_t* parent, const char* txt)
-{
-    lv_obj_t* btn = lv_btn_create(parent);
-
-    // breedte 100%, hoogte wordt door flex verdeeld
-    lv_obj_set_width(btn, LV_PCT(100));
-    lv_obj_set_height(btn, LV_SIZE_CONTENT);
-    lv_obj_set_flex_grow(btn, 1);
-
-    lv_obj_set_style_radius(btn, 0, LV_PART_MAIN);
-    lv_obj_set_style_bg_color(btn, lv_color_hex(UI_COL_BUTTON_BG), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(btn, LV_OPA_COVER, LV_PART_MAIN);
-    lv_obj_set_style_border_color(btn, lv_color_hex(UI_COL_BUTTON_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(btn, 1, LV_PART_MAIN);
-
-    lv_obj_clear_flag(btn, LV_OBJ_FLAG_SCROLLABLE);
-    lv_obj_set_scrollbar_mode(btn, LV_SCROLLBAR_MODE_OFF);
-
-    lv_obj_t* l = lv_label_create(btn);
-    lv_label_set_text(l, txt);
-    lv_obj_center(l);
-
-    lv_obj_set_style_text_font(l, &lv_font_montserrat_12, LV_PART_MAIN);
-    lv_obj_set_style_text_color(l, lv_color_hex(UI_COL_BUTTON_TEXT), 0);
-
-    return btn;
-}
+// laatst getoonde waarden
+static struct {
+  uibind::Field pct, voltage, ampere;
+} ui2_bind;
 
 void ui2_create()
 {
-    lv_obj_t* scr = lv_screen_active();
-    lv_obj_clean(scr);
+    if (ui_built(1)) return;
+    lv_obj_t* scr = ui_screen_begin(1);
+    ui2_bind = {};
 
     // --- Screen background ---
-    lv_obj_set_style_bg_color(scr, lv_color_hex(UI_COL_BG), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, LV_PART_MAIN);
+    ui_theme_apply(scr, UI_STYLE_SCREEN);
 
     // --- Title ---
-    lv_obj_t* title = lv_label_create(scr);
-    lv_label_set_text(title, "constant scource"); // laat je spelling zoals in je ontwerp
-    lv_obj_set_style_text_color(title, lv_color_hex(UI_COL_TEXT), 0);
-    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 5);
+    ui_theme_label(scr, "constant scource", UI_STYLE_TITLE); // laat je spelling zoals in je ontwerp
 
     // --- Sidebar rechts (zelfde idee als UI1) ---
-    lv_obj_t* sidebar = lv_obj_create(scr);
-    lv_obj_set_size(sidebar, 120, 300);
-    lv_obj_align(sidebar, LV_ALIGN_RIGHT_MID, -5, 5);
-
-    lv_obj_set_style_bg_color(sidebar, lv_color_hex(UI_COL_SIDEBAR_BG), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(sidebar, LV_OPA_COVER, LV_PART_MAIN);
-    lv_obj_set_style_border_color(sidebar, lv_color_hex(UI_COL_SIDEBAR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(sidebar, 1, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(sidebar, 4, LV_PART_MAIN);
-    lv_obj_set_style_pad_gap(sidebar, 4, LV_PART_MAIN);
-
-    lv_obj_set_flex_flow(sidebar, LV_FLEX_FLOW_COLUMN);
-    lv_obj_set_flex_align(sidebar,
-                          LV_FLEX_ALIGN_START,
-                          LV_FLEX_ALIGN_CENTER,
-                          LV_FLEX_ALIGN_START);
-
-    lv_obj_clear_flag(sidebar, LV_OBJ_FLAG_SCROLLABLE);
-    lv_obj_set_scrollbar_mode(sidebar, LV_SCROLLBAR_MODE_OFF);
-
-    ui2_btn_voltage       = ui2_make_btn(sidebar, "Voltage");
-    ui2_btn_current_limit = ui2_make_btn(sidebar, "current limit");
-    ui2_btn_empty3        = ui2_make_btn(sidebar, "");       // leeg
-    ui2_btn_empty4        = ui2_make_btn(sidebar, "");       // leeg
-    ui2_btn_reset         = ui2_make_btn(sidebar, "Reset");
-
-    // --- Arc gauge ---
-    ui2_arc = lv_arc_create(scr);
-    lv_obj_set_size(ui2_arc, 180, 180);
-    lv_obj_align(ui2_arc, LV_ALIGN_CENTER, -60, -5);
-
-    // Arc instellingen: 0..100%
-    lv_arc_set_range(ui2_arc, 0, 100);
-
-    // Full ring zichtbaar (achtergrondring)
-    lv_arc_set_bg_angles(ui2_arc, 0, 360);
-
-    // Start onderaan: rotation op 270 graden (6 o’clock als startpunt)
-    lv_arc_set_rotation(ui2_arc, 270);
-
-    // Background ring (vaste 360°)
-    lv_obj_set_style_arc_width(ui2_arc, 12, LV_PART_MAIN);
-    lv_obj_set_style_arc_color(ui2_arc,
-                            lv_color_hex(0x5A5400), // donker geel / olijf
-                            LV_PART_MAIN);
-
-    // Indicator ring (bewegend deel)
-    lv_obj_set_style_arc_width(ui2_arc, 12, LV_PART_INDICATOR);
-    lv_obj_set_style_arc_color(ui2_arc,
-                            lv_color_hex(UI_COL_CHART_SERIES), // helder geel
-                            LV_PART_INDICATOR);
-
-    // Knob verbergen
-    lv_obj_set_style_opa(ui2_arc, LV_OPA_TRANSP, LV_PART_KNOB);
-
-    // Geen input / scroll
-    lv_obj_clear_flag(ui2_arc, LV_OBJ_FLAG_CLICKABLE);
-    lv_obj_clear_flag(ui2_arc, LV_OBJ_FLAG_SCROLLABLE);
-    lv_obj_set_scrollbar_mode(ui2_arc, LV_SCROLLBAR_MODE_OFF);
-
-    // Startwaarde 0%
-    lv_arc_set_value(ui2_arc, 0);
+    lv_obj_t* sidebar = ui_theme_sidebar(scr);
+
+    ui2_btn_voltage       = ui_theme_button(sidebar, "Voltage");
+    ui2_btn_current_limit = ui_theme_button(sidebar, "current limit");
+    ui2_btn_empty3        = ui_theme_button(sidebar, "");       // leeg
+    ui2_btn_empty4        = ui_theme_button(sidebar, "");       // leeg
+    ui2_btn_reset         = ui_theme_button(sidebar, "Reset");
+
+    // --- Ring gauge: 0..100%, start boven, donker gele ring met helder gele indicator ---
+    ui2_gauge = ui_gauge_create(scr, 180, 12, 270, 100,
+                                lv_color_hex(UI_COL_GAUGE_RING), lv_color_hex(UI_COL_CHART_SERIES));
+    lv_obj_align(ui2_gauge, LV_ALIGN_CENTER, -60, -5);
 
     // --- Voltage label IN de cirkel ---
-    ui2_label_voltage = lv_label_create(scr);
-    lv_obj_set_style_text_color(ui2_label_voltage, lv_color_hex(UI_COL_TEXT), 0);
-    lv_label_set_text(ui2_label_voltage, "Voltage:\n0.00");
-    lv_obj_align_to(ui2_label_voltage, ui2_arc, LV_ALIGN_CENTER, 0, 0);
+    ui2_label_voltage = ui_theme_label(scr, "Voltage:\n0.00", UI_STYLE_TEXT);
+    lv_obj_align_to(ui2_label_voltage, ui2_gauge, LV_ALIGN_CENTER, 0, 0);
 
     // --- Ampere label onder de cirkel ---
-    ui2_label_ampere = lv_label_create(scr);
-    lv_obj_set_style_text_color(ui2_label_ampere, lv_color_hex(UI_COL_TEXT), 0);
-    lv_label_set_text(ui2_label_ampere, "Ampere:\n0.00");
-    lv_obj_align_to(ui2_label_ampere, ui2_arc, LV_ALIGN_OUT_BOTTOM_MID, 0, 20);
+    ui2_label_ampere = ui_theme_label(scr, "Ampere:\n0.00", UI_STYLE_TEXT);
+    lv_obj_align_to(ui2_label_ampere, ui2_gauge, LV_ALIGN_OUT_BOTTOM_MID, 0, 20);
 }
 
 void ui2_update(const DisplayModel& m)
@@ -444,29 +439,20 @@ void ui2_update(const DisplayModel& m)
     if (pct < 0) pct = 0;
     if (pct > 100) pct = 100;
 
-    if (ui2_arc) {
-        lv_arc_set_value(ui2_arc, pct);
+    if (ui2_gauge && ui2_bind.pct.set(pct)) {
+        ui_gauge_set_value(ui2_gauge, pct);
     }
 
     // Labels updaten
-    if (ui2_label_voltage) {
-        char b[32];
-        snprintf(b, sizeof(b), "Voltage:\n%.2f", m.ui2.set_voltage);
-        lv_label_set_text(ui2_label_voltage, b);
-    }
-
-    if (ui2_label_ampere) {
-        char b[32];
-        snprintf(b, sizeof(b), "Ampere:\n%.2f", m.ui2.meas_ampere);
-        lv_label_set_text(ui2_label_ampere, b);
-    }
+    set_centi(ui2_bind.voltage, ui2_label_voltage, m.ui2.set_voltage, "Voltage:\n", "");
+    set_centi(ui2_bind.ampere, ui2_label_ampere, m.ui2.meas_ampere, "Ampere:\n", "");
 }
 
 
 // ================= UI 3: Constant sink (gauge) =================
 
 // UI3 object pointers
-static lv_obj_t* ui3_arc             = nullptr;
+static lv_obj_t* ui3_gauge           = nullptr;
 static lv_obj_t* ui3_label_ampere    = nullptr;  // in de cirkel: ingestelde A
 static lv_obj_t* ui3_label_voltage   = nullptr;  // onder de cirkel: gemeten V
 
@@ -477,113 +463,44 @@ static lv_obj_t* ui3_btn_empty3        = nullptr;
 static lv_obj_t* ui3_btn_empty4        = nullptr;
 static lv_obj_t* ui3_btn_reset         = nullptr;
 
-// helper: maak button met jouw style (zelfde als UI2/1)
-static lv_obj_t* ui3_make_btn(lv_obj_t* parent, const char* txt)
-{
-    lv_obj_t* btn = lv_btn_create(parent);
-
-    // breedte 100%, hoogte door flex verdeeld
-    lv_obj_set_width(btn, LV_PCT(100));
-    lv_obj_set_height(btn, LV_SIZE_CONTENT);
-    lv_obj_set_flex_grow(btn, 1);
-
-    lv_obj_set_style_radius(btn, 0, LV_PART_MAIN);
-    lv_obj_set_style_bg_color(btn, lv_color_hex(UI_COL_BUTTON_BG), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(btn, LV_OPA_COVER, LV_PART_MAIN);
-    lv_obj_set_style_border_color(btn, lv_color_hex(UI_COL_BUTTON_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(btn, 1, LV_PART_MAIN);
-
-    lv_obj_clear_flag(btn, LV_OBJ_FLAG_SCROLLABLE);
-    lv_obj_set_scrollbar_mode(btn, LV_SCROLLBAR_MODE_OFF);
-
-    lv_obj_t* l = lv_label_create(btn);
-    lv_label_set_text(l, txt);
-    lv_obj_center(l);
-
-    lv_obj_set_style_text_font(l, &lv_font_montserrat_12, LV_PART_MAIN);
-    lv_obj_set_style_text_color(l, lv_color_hex(UI_COL_BUTTON_TEXT), 0);
-
-    return btn;
-}
+// laatst getoonde waarden
+static struct {
+  uibind::Field pct, ampere, voltage;
+} ui3_bind;
 
 void ui3_create()
 {
-    lv_obj_t* scr = lv_screen_active();
-    lv_obj_clean(scr);
+    if (ui_built(2)) return;
+    lv_obj_t* scr = ui_screen_begin(2);
+    ui3_bind = {};
 
     // achtergrond
-    lv_obj_set_style_bg_color(scr, lv_color_hex(UI_COL_BG), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, LV_PART_MAIN);
+    ui_theme_apply(scr, UI_STYLE_SCREEN);
 
     // titel
-    lv_obj_t* title = lv_label_create(scr);
-    lv_label_set_text(title, "constant sink");
-    lv_obj_set_style_text_color(title, lv_color_hex(UI_COL_TEXT), 0);
-    lv_obj_align(title, LV_ALIGN_TOP_MID, 0, 5);
+    ui_theme_label(scr, "constant sink", UI_STYLE_TITLE);
 
     // sidebar rechts
-    lv_obj_t* sidebar = lv_obj_create(scr);
-    lv_obj_set_size(sidebar, 120, 300);
-    lv_obj_align(sidebar, LV_ALIGN_RIGHT_MID, -5, 5);
-
-    lv_obj_set_style_bg_color(sidebar, lv_color_hex(UI_COL_SIDEBAR_BG), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(sidebar, LV_OPA_COVER, LV_PART_MAIN);
-    lv_obj_set_style_border_color(sidebar, lv_color_hex(UI_COL_SIDEBAR_BORDER), LV_PART_MAIN);
-    lv_obj_set_style_border_width(sidebar, 1, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(sidebar, 4, LV_PART_MAIN);
-    lv_obj_set_style_pad_gap(sidebar, 4, LV_PART_MAIN);
-
-    lv_obj_set_flex_flow(sidebar, LV_FLEX_FLOW_COLUMN);
-    lv_obj_set_flex_align(sidebar,
-                          LV_FLEX_ALIGN_START,
-                          LV_FLEX_ALIGN_CENTER,
-                          LV_FLEX_ALIGN_START);
-
-    lv_obj_clear_flag(sidebar, LV_OBJ_FLAG_SCROLLABLE);
-    lv_obj_set_scrollbar_mode(sidebar, LV_SCROLLBAR_MODE_OFF);
-
-    ui3_btn_ampere = ui3_make_btn(sidebar, "Ampere");
-    ui3_btn_vlimit = ui3_make_btn(sidebar, "voltage limit");
-    ui3_btn_empty3 = ui3_make_btn(sidebar, "");
-    ui3_btn_empty4 = ui3_make_btn(sidebar, "");
-    ui3_btn_reset  = ui3_make_btn(sidebar, "Reset");
-
-    // arc + labels links (zelfde plaatsing-aanpak als UI2)
-    ui3_arc = lv_arc_create(scr);
-    lv_obj_set_size(ui3_arc, 180, 180);
-    lv_obj_align(ui3_arc, LV_ALIGN_CENTER, -60, -5);
-
-    // arc instellingen 0..100%
-    lv_arc_set_range(ui3_arc, 0, 100);
-    lv_arc_set_bg_angles(ui3_arc, 0, 360);
-    lv_arc_set_rotation(ui3_arc, 270);
-
-    // background ring (iets donkerder geel), indicator helder geel
-    lv_obj_set_style_arc_width(ui3_arc, 12, LV_PART_MAIN);
-    lv_obj_set_style_arc_color(ui3_arc, lv_color_hex(0x5A5400), LV_PART_MAIN);
-
-    lv_obj_set_style_arc_width(ui3_arc, 12, LV_PART_INDICATOR);
-    lv_obj_set_style_arc_color(ui3_arc, lv_color_hex(UI_COL_CHART_SERIES), LV_PART_INDICATOR);
-
-    // knob verbergen + geen input
-    lv_obj_set_style_opa(ui3_arc, LV_OPA_TRANSP, LV_PART_KNOB);
-    lv_obj_clear_flag(ui3_arc, LV_OBJ_FLAG_CLICKABLE);
-    lv_obj_clear_flag(ui3_arc, LV_OBJ_FLAG_SCROLLABLE);
-    lv_obj_set_scrollbar_mode(ui3_arc, LV_SCROLLBAR_MODE_OFF);
-
-    lv_arc_set_value(ui3_arc, 0);
+    lv_obj_t* sidebar = ui_theme_sidebar(scr);
+
+    ui3_btn_ampere = ui_theme_button(sidebar, "Ampere");
+    ui3_btn_vlimit = ui_theme_button(sidebar, "voltage limit");
+    ui3_btn_empty3 = ui_theme_button(sidebar, "");
+    ui3_btn_empty4 = ui_theme_button(sidebar, "");
+    ui3_btn_reset  = ui_theme_button(sidebar, "Reset");
+
+    // gauge + labels links (zelfde als UI2)
+    ui3_gauge = ui_gauge_create(scr, 180, 12, 270, 100,
+                                lv_color_hex(UI_COL_GAUGE_RING), lv_color_hex(UI_COL_CHART_SERIES));
+    lv_obj_align(ui3_gauge, LV_ALIGN_CENTER, -60, -5);
 
     // label in de cirkel: ingestelde ampere
-    ui3_label_ampere = lv_label_create(scr);
-    lv_obj_set_style_text_color(ui3_label_ampere, lv_color_hex(UI_COL_TEXT), 0);
-    lv_label_set_text(ui3_label_ampere, "Ampere:\n0.00");
-    lv_obj_align_to(ui3_label_ampere, ui3_arc, LV_ALIGN_CENTER, 0, 0);
+    ui3_label_ampere = ui_theme_label(scr, "Ampere:\n0.00", UI_STYLE_TEXT);
+    lv_obj_align_to(ui3_label_ampere, ui3_gauge, LV_ALIGN_CENTER, 0, 0);
 
     // label onder de cirkel: gemeten voltage
-    ui3_label_voltage = lv_label_create(scr);
-    lv_obj_set_style_text_color(ui3_label_voltage, lv_color_hex(UI_COL_TEXT), 0);
-    lv_label_set_text(ui3_label_voltage, "Voltage:\n0.00");
-    lv_obj_align_to(ui3_label_voltage, ui3_arc, LV_ALIGN_OUT_BOTTOM_MID, 0, 20);
+    ui3_label_voltage = ui_theme_label(scr, "Voltage:\n0.00", UI_STYLE_TEXT);
+    lv_obj_align_to(ui3_label_voltage, ui3_gauge, LV_ALIGN_OUT_BOTTOM_MID, 0, 20);
 }
 
 void ui3_update(const DisplayModel& m)
@@ -595,20 +512,11 @@ void ui3_update(const DisplayModel& m)
     if (pct < 0) pct = 0;
     if (pct > 100) pct = 100;
 
-    if (ui3_arc) {
-        lv_arc_set_value(ui3_arc, pct);
+    if (ui3_gauge && ui3_bind.pct.set(pct)) {
+        ui_gauge_set_value(ui3_gauge, pct);
     }
 
     // labels updaten
-    if (ui3_label_ampere) {
-        char b[32];
-        snprintf(b, sizeof(b), "Ampere:\n%.2f", m.ui3.set_ampere);
-        lv_label_set_text(ui3_label_ampere, b);
-    }
-
-    if (ui3_label_voltage) {
-        char b[32];
-        snprintf(b, sizeof(b), "Voltage:\n%.2f", m.ui3.meas_voltage);
-        lv_label_set_text(ui3_label_voltage, b);
-    }
+    set_centi(ui3_bind.ampere, ui3_label_ampere, m.ui3.set_ampere, "Ampere:\n", "");
+    set_centi(ui3_bind.voltage, ui3_label_voltage, m.ui3.meas_voltage, "Voltage:\n", "");
 }
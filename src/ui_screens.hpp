@@ -2,9 +2,15 @@
 #include <stdint.h>
 
 struct UI1Model {
-  int16_t curve[32];
-  int     curve_len;
-  int     progress_index;
+  // Ontladingscurve (waarden 0..100) van willekeurige lengte; het model wijst
+  // alleen naar de data. curve_rev ophogen als de inhoud verandert.
+  const int16_t* curve;
+  uint32_t       curve_len;
+  uint32_t       curve_rev;
+  // Zoom: zichtbaar deel van de curve (view_len 0 = alles)
+  uint32_t       view_first;
+  uint32_t       view_len;
+  int            progress_index;   // punt in de curve
 
   float voltage_val;
   float current_val;
@@ -34,10 +40,27 @@ struct DisplayModel {
   UI3Model ui3;
 };
 
+// Elke UI staat op een eigen scherm dat één keer wordt opgebouwd (uiN_create
+// doet daarna niets meer); uiN_show maakt het actief via lv_screen_load.
+void ui_screens_create();
 void ui1_create();
 void ui2_create();
 void ui3_create();
+void ui1_show();
+void ui2_show();
+void ui3_show();
+
+// Overgang bij uiN_show: 0 = direct, anders fade-in van `ms` ms
+void ui_screens_set_transition(uint32_t ms);
+
+// Alleen voor metingen: false = oude gedrag (actief scherm leegmaken en bij
+// elke show opnieuw opbouwen). Gooit de bestaande schermen weg.
+void ui_screens_set_persistent(bool on);
+void ui_screens_reset();
 
 void ui1_update(const DisplayModel& m);
+
+// Positie en grootte van de UI1-chart (logische schermcoördinaten)
+void ui1_chart_area(int& x, int& y, int& w, int& h);
 void ui2_update(const DisplayModel& m);
 void ui3_update(const DisplayModel& m);
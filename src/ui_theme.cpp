@@ -0,0 +1,161 @@
+// ui_theme.cpp - gedeelde stijlen (zie ui_theme.hpp)
+#include "ui_theme.hpp"
+
+// Eigenschappen van een rol gaan naar de gedeelde stijl, of (ui_theme_set_shared(false))
+// als lokale stijl naar één object. Zo staat elke rol maar op één plek beschreven.
+struct UiStyleSink {
+  lv_style_t* style;
+  lv_obj_t*   obj;
+
+  void set(lv_style_prop_t prop, lv_style_value_t v) const {
+    if (style) lv_style_set_prop(style, prop, v);
+    else lv_obj_set_local_style_prop(obj, prop, v, LV_PART_MAIN);
+  }
+  void num(lv_style_prop_t prop, int32_t n) const {
+    lv_style_value_t v = {};
+    v.num = n;
+    set(prop, v);
+  }
+  void color(lv_style_prop_t prop, uint32_t hex) const {
+    lv_style_value_t v = {};
+    v.color = lv_color_hex(hex);
+    set(prop, v);
+  }
+  void ptr(lv_style_prop_t prop, const void* p) const {
+    lv_style_value_t v = {};
+    v.ptr = p;
+    set(prop, v);
+  }
+  void pad_all(int32_t n) const {
+    num(LV_STYLE_PAD_TOP, n);
+    num(LV_STYLE_PAD_BOTTOM, n);
+    num(LV_STYLE_PAD_LEFT, n);
+    num(LV_STYLE_PAD_RIGHT, n);
+  }
+};
+
+static void def_screen(const UiStyleSink& s) {
+  s.color(LV_STYLE_BG_COLOR, UI_COL_BG);
+  s.num(LV_STYLE_BG_OPA, LV_OPA_COVER);
+}
+
+static void def_title(const UiStyleSink& s) {
+  s.color(LV_STYLE_TEXT_COLOR, UI_COL_TEXT);
+  s.num(LV_STYLE_ALIGN, LV_ALIGN_TOP_MID);
+  s.num(LV_STYLE_Y, 5);
+}
+
+static void def_text(const UiStyleSink& s) {
+  s.color(LV_STYLE_TEXT_COLOR, UI_COL_TEXT);
+}
+
+static void def_axis_text(const UiStyleSink& s) {
+  s.color(LV_STYLE_TEXT_COLOR, UI_COL_AXIS_TEXT);
+}
+
+static void def_meas_text(const UiStyleSink& s) {
+  s.color(LV_STYLE_TEXT_COLOR, UI_COL_MEAS_TEXT);
+}
+
+static void def_chart(const UiStyleSink& s) {
+  s.color(LV_STYLE_BG_COLOR, UI_COL_CHART_BG);
+  s.color(LV_STYLE_BORDER_COLOR, UI_COL_CHART_BORDER);
+  s.num(LV_STYLE_BORDER_WIDTH, 1);
+}
+
+static void def_sidebar(const UiStyleSink& s) {
+  s.num(LV_STYLE_WIDTH, 120);
+  s.num(LV_STYLE_HEIGHT, 300);
+  s.num(LV_STYLE_ALIGN, LV_ALIGN_RIGHT_MID);
+  s.num(LV_STYLE_X, -5);
+  s.num(LV_STYLE_Y, 5);
+
+  s.color(LV_STYLE_BG_COLOR, UI_COL_SIDEBAR_BG);
+  s.num(LV_STYLE_BG_OPA, LV_OPA_COVER);
+  s.color(LV_STYLE_BORDER_COLOR, UI_COL_SIDEBAR_BORDER);
+  s.num(LV_STYLE_BORDER_WIDTH, 1);
+  s.pad_all(4);
+  s.num(LV_STYLE_PAD_ROW, 4);
+  s.num(LV_STYLE_PAD_COLUMN, 4);
+
+  s.num(LV_STYLE_LAYOUT, LV_LAYOUT_FLEX);
+  s.num(LV_STYLE_FLEX_FLOW, LV_FLEX_FLOW_COLUMN);
+  s.num(LV_STYLE_FLEX_MAIN_PLACE, LV_FLEX_ALIGN_START);
+  s.num(LV_STYLE_FLEX_CROSS_PLACE, LV_FLEX_ALIGN_CENTER);
+  s.num(LV_STYLE_FLEX_TRACK_PLACE, LV_FLEX_ALIGN_START);
+}
+
+static void def_button(const UiStyleSink& s) {
+  // Breedte 100%, hoogte door flex verdeeld
+  s.num(LV_STYLE_WIDTH, LV_PCT(100));
+  s.num(LV_STYLE_HEIGHT, LV_SIZE_CONTENT);
+  s.num(LV_STYLE_FLEX_GROW, 1);
+
+  s.num(LV_STYLE_RADIUS, 0);
+  s.color(LV_STYLE_BG_COLOR, UI_COL_BUTTON_BG);
+  s.num(LV_STYLE_BG_OPA, LV_OPA_COVER);
+  s.color(LV_STYLE_BORDER_COLOR, UI_COL_BUTTON_BORDER);
+  s.num(LV_STYLE_BORDER_WIDTH, 1);
+}
+
+static void def_button_text(const UiStyleSink& s) {
+  s.num(LV_STYLE_ALIGN, LV_ALIGN_CENTER);
+  s.ptr(LV_STYLE_TEXT_FONT, &lv_font_montserrat_12);
+  s.color(LV_STYLE_TEXT_COLOR, UI_COL_BUTTON_TEXT);
+}
+
+static void (*const UI_STYLE_DEFS[UI_STYLE_COUNT])(const UiStyleSink&) = {
+  def_screen, def_title, def_text, def_axis_text, def_meas_text,
+  def_chart, def_sidebar, def_button, def_button_text,
+};
+
+static lv_style_t ui_styles[UI_STYLE_COUNT];
+static bool       ui_styles_ready = false;
+static bool       ui_styles_shared = true;
+
+void ui_theme_init() {
+  if (ui_styles_ready) return;
+  for (int i = 0; i < UI_STYLE_COUNT; i++) {
+    lv_style_init(&ui_styles[i]);
+    UI_STYLE_DEFS[i](UiStyleSink{ &ui_styles[i], nullptr });
+  }
+  ui_styles_ready = true;
+}
+
+void ui_theme_set_shared(bool on) {
+  ui_styles_shared = on;
+}
+
+void ui_theme_apply(lv_obj_t* obj, UiStyle style) {
+  if (ui_styles_shared) {
+    ui_theme_init();
+    lv_obj_add_style(obj, &ui_styles[style], LV_PART_MAIN);
+  } else {
+    UI_STYLE_DEFS[style](UiStyleSink{ nullptr, obj });
+  }
+}
+
+lv_obj_t* ui_theme_label(lv_obj_t* parent, const char* txt, UiStyle style) {
+  lv_obj_t* l = lv_label_create(parent);
+  lv_label_set_text(l, txt);
+  ui_theme_apply(l, style);
+  return l;
+}
+
+lv_obj_t* ui_theme_sidebar(lv_obj_t* parent) {
+  lv_obj_t* sidebar = lv_obj_create(parent);
+  ui_theme_apply(sidebar, UI_STYLE_SIDEBAR);
+  lv_obj_clear_flag(sidebar, LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_set_scrollbar_mode(sidebar, LV_SCROLLBAR_MODE_OFF);
+  return sidebar;
+}
+
+lv_obj_t* ui_theme_button(lv_obj_t* parent, const char* txt) {
+  lv_obj_t* btn = lv_btn_create(parent);
+  ui_theme_apply(btn, UI_STYLE_BUTTON);
+  lv_obj_clear_flag(btn, LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_set_scrollbar_mode(btn, LV_SCROLLBAR_MODE_OFF);
+
+  ui_theme_label(btn, txt, UI_STYLE_BUTTON_TEXT);
+  return btn;
+}
@@ -0,0 +1,53 @@
+// ui_theme.hpp - geel-op-zwart palet en gedeelde LVGL-stijlen voor UI1/2/3
+#pragma once
+#include <stdint.h>
+#include <lvgl.h>
+
+// --- UI color palette ---
+#define UI_COL_BG              0x000000   // global background
+#define UI_COL_TEXT            0xEDBE0E   // main text (yellow)
+#define UI_COL_CHART_BG        0x000000   // chart background
+#define UI_COL_CHART_BORDER    0xEDBE0E   // chart border
+#define UI_COL_CHART_SERIES    0xEDBE0E   // discharge curve
+#define UI_COL_CHART_LINE      0xEDBE0E   // helper line in chart
+#define UI_COL_AXIS_TEXT       0xEDBE0E   // axis labels
+#define UI_COL_MEAS_TEXT       0xEDBE0E   // measurement & curve info text
+#define UI_COL_SIDEBAR_BG      0xEDBE0E   // sidebar background
+#define UI_COL_SIDEBAR_BORDER  0x000000   // sidebar border lines
+#define UI_COL_BUTTON_BG       0xEDBE0E   // button background (yellow)
+#define UI_COL_BUTTON_BORDER   0x000000   // button border
+#define UI_COL_BUTTON_TEXT     0x000000   // button text
+#define UI_COL_GAUGE_RING      0x5A5400   // gauge background ring (dark yellow / olive)
+
+// Eén lv_style_t per rol, één keer opgebouwd en door alle objecten gedeeld
+// (lv_obj_add_style houdt alleen een pointer bij, geen kopie per object).
+enum UiStyle {
+  UI_STYLE_SCREEN,        // achtergrond van een scherm
+  UI_STYLE_TITLE,         // titel bovenaan in het midden
+  UI_STYLE_TEXT,          // gewone tekst
+  UI_STYLE_AXIS_TEXT,     // as-labels van de chart
+  UI_STYLE_MEAS_TEXT,     // meetwaarden en curve-info
+  UI_STYLE_CHART,         // chart-vlak en rand
+  UI_STYLE_SIDEBAR,       // knoppenkolom rechts, incl. plaats en flex
+  UI_STYLE_BUTTON,        // knop in de sidebar
+  UI_STYLE_BUTTON_TEXT,   // label in een knop
+  UI_STYLE_COUNT
+};
+
+// Bouwt de stijlen op; meerdere keren aanroepen is onschadelijk
+void ui_theme_init();
+
+void ui_theme_apply(lv_obj_t* obj, UiStyle style);
+
+// Label met tekst en stijl
+lv_obj_t* ui_theme_label(lv_obj_t* parent, const char* txt, UiStyle style);
+
+// Sidebar rechts met flex-kolom; knoppen erin via ui_theme_button
+lv_obj_t* ui_theme_sidebar(lv_obj_t* parent);
+
+// Knop die in de flex-kolom de hoogte gelijk verdeelt, met gecentreerd label (child 0)
+lv_obj_t* ui_theme_button(lv_obj_t* parent, const char* txt);
+
+// Alleen voor metingen: false = dezelfde eigenschappen als lokale stijl op elk
+// object (het oude gedrag). Geldt voor objecten die daarna gemaakt worden.
+void ui_theme_set_shared(bool on);
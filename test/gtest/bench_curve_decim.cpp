@@ -0,0 +1,51 @@
+// bench_curve_decim.cpp - 100k-punts ontladingscurve naar 310 chartkolommen: min/max vs LTTB (host)
+// Zinvolle getallen alleen met optimalisatie: cmake -DCMAKE_BUILD_TYPE=Release
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "curve_decim.hpp"
+
+static volatile int32_t sink = 0;
+
+template <class F>
+static double us_per_call(F&& f, int reps) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < reps; ++r) f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(t1 - t0).count() / reps;
+}
+
+int main() {
+    constexpr uint32_t COLS = 310;
+    constexpr int REPS = 200;
+
+    std::printf("decimatie naar %u kolommen (%d rondes)\n", COLS, REPS);
+    std::printf("  %8s %12s %12s %12s\n", "punten", "minmax us", "lttb us", "cache-hit us");
+    for (uint32_t n : {10000u, 100000u, 1000000u}) {
+        std::vector<int16_t> y(n);
+        uint32_t seed = 1;
+        for (uint32_t i = 0; i < n; i++) {
+            seed = seed * 1103515245u + 12345u;
+            y[i] = int16_t(100 - int64_t(100) * i / n + int((seed >> 16) % 3) - 1);
+        }
+
+        std::vector<int32_t> out(2 * COLS);
+        const double mm = us_per_call([&] {
+            sink = sink + int32_t(curvedecim::minmax(y.data(), 0, n, COLS, out.data())) + out[7];
+        }, REPS);
+        const double lt = us_per_call([&] {
+            sink = sink + int32_t(curvedecim::lttb(y.data(), 0, n, COLS, out.data())) + out[7];
+        }, REPS);
+
+        // Wat ui1_update elke seconde doet als de curve niet veranderde
+        static curvedecim::Cache<COLS> cache;
+        cache.reset();
+        cache.update(y.data(), n, 1, 0, 0);
+        const double hit = us_per_call([&] {
+            sink = sink + (cache.update(y.data(), n, 1, 0, 0) ? 1 : 0);
+        }, REPS * 1000);
+
+        std::printf("  %8u %12.1f %12.1f %12.3f\n", n, mm, lt, hit);
+    }
+    return 0;
+}
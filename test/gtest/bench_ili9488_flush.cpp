@@ -0,0 +1,94 @@
+// bench_ili9488_flush.cpp - CPU-kost per pixel van de flush: conversie vs native (host)
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "ili9488_driver.hpp"
+
+// Registers die niks loggen: meet alleen wat de CPU per byte moet doen
+struct NullGpioRegs {
+    static inline volatile uint32_t sink = 0;
+    template <int Bank> static inline void set(uint32_t m) { sink = m; }
+    template <int Bank> static inline void clr(uint32_t m) { sink = m; }
+};
+
+// DMA-engine die niks verstuurt: meet alleen staging/conversie
+struct NullDmaEngine {
+    static inline volatile size_t sink = 0;
+    static void init(size_t) {}
+    static uint8_t* alloc(size_t n) {
+        static std::vector<std::vector<uint8_t>> bufs;
+        bufs.emplace_back(n);
+        return bufs.back().data();
+    }
+    static void tx_param(uint8_t, const uint8_t*, size_t) {}
+    static void tx_color(uint8_t, const uint8_t* buf, size_t n) { sink = sink + buf[n - 1]; }
+    static void wait_pending(uint32_t) {}
+};
+
+using NullBus = lcdbus::ParallelBus8<Ili9488Pins, NullGpioRegs>;
+
+// Zelfde lus als BitBangTransportT::pixels, maar op NullBus i.p.v. de loggende nep-registers
+template <class Fmt>
+static void bitbang_pixels(const uint8_t* px, uint32_t count) {
+    if constexpr (Fmt::kRaw) {
+        for (uint32_t i = 0; i < 2 * count; i++) NullBus::write(px[i]);
+    } else {
+        for (uint32_t i = 0; i < count; i++) {
+            uint16_t c = Fmt::panel(px[2 * i], px[2 * i + 1]);
+            NullBus::write(c >> 8);
+            NullBus::write(c & 0xFF);
+        }
+    }
+}
+
+// Effen vlak: scan + herhaalde kleur (WR-only als hoge == lage byte)
+static void bitbang_solid(const uint8_t* px, uint32_t count) {
+    uint16_t c;
+    if (!ili9488_area_solid(px, count, c)) return;
+    const uint16_t p = Ili9488PixelFormat::fill(c);
+    if ((p >> 8) == (p & 0xFF)) {
+        NullBus::write(p & 0xFF);
+        for (uint32_t i = 1; i < 2 * count; i++) NullBus::strobe();
+    } else {
+        for (uint32_t i = 0; i < count; i++) { NullBus::write(p >> 8); NullBus::write(p & 0xFF); }
+    }
+}
+
+template <class F>
+static double ns_per_pixel(F&& f, uint32_t pixels, int reps) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < reps; ++r) f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / (double(pixels) * reps);
+}
+
+int main() {
+    constexpr uint32_t W = 480, H = 320, N = W * H;
+    constexpr int REPS = 50;
+    std::vector<uint8_t> frame(2 * N);
+    for (uint32_t i = 0; i < frame.size(); ++i) frame[i] = uint8_t(i * 31);
+
+    using InvDma = I80DmaTransport<NullDmaEngine, ILI9488_I80_CHUNK_BYTES, Rgb565Inverted>;
+    using NatDma = I80DmaTransport<NullDmaEngine, ILI9488_I80_CHUNK_BYTES, Rgb565Native>;
+    InvDma::init();
+    NatDma::init();
+
+    const double bb_inv = ns_per_pixel([&] { bitbang_pixels<Rgb565Inverted>(frame.data(), N); }, N, REPS);
+    const double bb_nat = ns_per_pixel([&] { bitbang_pixels<Rgb565Native>(frame.data(), N); }, N, REPS);
+    std::vector<uint8_t> black(2 * N, 0x00);
+    const double bb_black_stream = ns_per_pixel([&] { bitbang_pixels<Rgb565Inverted>(black.data(), N); }, N, REPS);
+    const double bb_black_solid  = ns_per_pixel([&] { bitbang_solid(black.data(), N); }, N, REPS);
+    const double dma_inv = ns_per_pixel([&] {
+        InvDma::begin_ramwr(0, 0, W, H); InvDma::pixels(frame.data(), N); InvDma::end_ramwr(); }, N, REPS);
+    const double dma_nat = ns_per_pixel([&] {
+        NatDma::begin_ramwr(0, 0, W, H); NatDma::pixels(frame.data(), N); NatDma::end_ramwr(); }, N, REPS);
+
+    std::printf("flush CPU-kost per pixel (%ux%u, %d frames)\n", W, H, REPS);
+    std::printf("  %-22s %8.3f ns/px\n", "bit-bang  inverted", bb_inv);
+    std::printf("  %-22s %8.3f ns/px\n", "bit-bang  native", bb_nat);
+    std::printf("  %-22s %8.3f ns/px\n", "bit-bang  zwart stream", bb_black_stream);
+    std::printf("  %-22s %8.3f ns/px\n", "bit-bang  zwart effen", bb_black_solid);
+    std::printf("  %-22s %8.3f ns/px\n", "i80 DMA   inverted", dma_inv);
+    std::printf("  %-22s %8.3f ns/px\n", "i80 DMA   native", dma_nat);
+    return 0;
+}
@@ -0,0 +1,64 @@
+// bench_ui_fmt.cpp - CPU-kost per label-tekst: snprintf("%.2f") op float vs uifmt op scaled integers (host)
+// Zinvolle getallen alleen met optimalisatie: cmake -DCMAKE_BUILD_TYPE=Release
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "ui_fmt.hpp"
+
+static volatile char sink = 0;
+
+template <class F>
+static double ns_per_call(F&& f, size_t calls, int reps) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < reps; ++r) f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / (double(calls) * reps);
+}
+
+int main() {
+    constexpr size_t N = 10000;
+    constexpr int REPS = 50;
+
+    // Zelfde waardebereik als de readouts: 0..20 V in mV, runtime tot 100 minuten
+    std::vector<float>    volts(N);
+    std::vector<int32_t>  mv(N);
+    std::vector<uint32_t> secs(N);
+    for (size_t i = 0; i < N; ++i) {
+        mv[i]    = int32_t((i * 7919) % 20000);
+        volts[i] = mv[i] / 1000.0f;
+        secs[i]  = uint32_t((i * 104729) % 6000);
+    }
+
+    char buf[48];
+    const double printf_v = ns_per_call([&] {
+        for (size_t i = 0; i < N; ++i) {
+            std::snprintf(buf, sizeof(buf), "Voltage = %.2f V", volts[i]);
+            sink = sink + buf[11];
+        }
+    }, N, REPS);
+    const double fmt_v = ns_per_call([&] {
+        for (size_t i = 0; i < N; ++i) {
+            uifmt::Writer(buf, sizeof(buf)).str("Voltage = ").fixed(mv[i], 3, 2).str(" V");
+            sink = sink + buf[11];
+        }
+    }, N, REPS);
+    const double printf_t = ns_per_call([&] {
+        for (size_t i = 0; i < N; ++i) {
+            std::snprintf(buf, sizeof(buf), "Run-time = %02u:%02u", unsigned(secs[i] / 60), unsigned(secs[i] % 60));
+            sink = sink + buf[12];
+        }
+    }, N, REPS);
+    const double fmt_t = ns_per_call([&] {
+        for (size_t i = 0; i < N; ++i) {
+            uifmt::Writer(buf, sizeof(buf)).str("Run-time = ").mmss(secs[i]);
+            sink = sink + buf[12];
+        }
+    }, N, REPS);
+
+    std::printf("label-formattering per aanroep (%zu waarden, %d rondes)\n", N, REPS);
+    std::printf("  %-26s %8.1f ns\n", "snprintf %.2f (float)", printf_v);
+    std::printf("  %-26s %8.1f ns\n", "uifmt fixed (mV)", fmt_v);
+    std::printf("  %-26s %8.1f ns\n", "snprintf %02u:%02u", printf_t);
+    std::printf("  %-26s %8.1f ns\n", "uifmt mmss", fmt_t);
+    return 0;
+}
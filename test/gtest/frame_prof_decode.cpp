@@ -0,0 +1,71 @@
+// frame_prof_decode.cpp - profiler-records uit een serial-capture lezen en samenvatten
+//
+//   frame_prof_decode capture.bin            percentielen + flame-samenvatting
+//   frame_prof_decode capture.bin --folded   alleen folded stacks (flamegraph.pl)
+//   cat /dev/ttyACM0 | frame_prof_decode -   live van stdin
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "frame_prof.hpp"
+#include "frame_prof_stats.hpp"
+using namespace frameprof;
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "gebruik: %s <capture.bin|-> [--folded]\n", argv[0]);
+        return 2;
+    }
+    const bool folded_only = argc > 2 && std::strcmp(argv[2], "--folded") == 0;
+    FILE* f = std::strcmp(argv[1], "-") == 0 ? stdin : std::fopen(argv[1], "rb");
+    if (!f) { std::perror(argv[1]); return 1; }
+
+    Decoder dec;
+    std::vector<FrameRecord> recs;
+    FrameRecord r;
+    int c;
+    while ((c = std::fgetc(f)) != EOF) {
+        if (dec.feed(static_cast<uint8_t>(c), r)) recs.push_back(r);
+    }
+    if (f != stdin) std::fclose(f);
+
+    const Summary s = summarize(recs);
+    const std::vector<std::string> stacks = folded_stacks(s);
+    if (folded_only) {
+        for (const auto& l : stacks) std::printf("%s\n", l.c_str());
+        return 0;
+    }
+
+    std::printf("%zu frames, %u verloren, %u foute records, %u bytes tekst/ruis\n",
+                s.frames, s.lost, dec.bad(), dec.skipped());
+    if (recs.empty()) return 0;
+    std::printf("gem. %.1f invalidaties en %.1f flushes per frame\n\n",
+                double(s.inv_areas) / s.frames, double(s.flushes) / s.frames);
+
+    std::printf("%-12s %10s %10s %10s %10s %10s\n", "", "p50", "p90", "p99", "max", "gem");
+    for (const Metric& m : metrics()) {
+        std::vector<uint32_t> v;
+        uint64_t sum = 0;
+        for (const auto& x : recs) { v.push_back(x.*m.field); sum += x.*m.field; }
+        std::printf("%-12s %10u %10u %10u %10u %10.0f\n", m.name,
+                    percentile(v, 50), percentile(v, 90), percentile(v, 99), percentile(v, 100),
+                    double(sum) / v.size());
+    }
+
+    // Flame-achtige samenvatting: aandeel per stack, als balk
+    std::printf("\n");
+    uint64_t total = 0;
+    std::vector<std::pair<std::string, uint64_t>> parts;
+    for (const auto& l : stacks) {
+        const size_t sp = l.rfind(' ');
+        const uint64_t us = std::strtoull(l.c_str() + sp + 1, nullptr, 10);
+        parts.emplace_back(l.substr(0, sp), us);
+        total += us;
+    }
+    for (const auto& p : parts) {
+        const int bar = total ? int(50.0 * p.second / total + 0.5) : 0;
+        std::printf("%-42s %5.1f%% %s\n", p.first.c_str(), total ? 100.0 * p.second / total : 0.0,
+                    std::string(bar, '#').c_str());
+    }
+    return 0;
+}
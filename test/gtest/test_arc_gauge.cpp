@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "arc_gauge.hpp"
+using namespace arcgauge;
+
+// Zelfde maat als ui2/ui3: 180x180, ring van 12 px, 0..100%, start boven (270 graden)
+class ArcGaugeTest : public ::testing::Test {
+protected:
+    void SetUp() override { ASSERT_TRUE(ring.init(180, 12, 270, 100)); }
+    void TearDown() override { ring.release(); }
+
+    // Indicator zoals hij bij waarde v hoort, volledig opnieuw gerasterd
+    std::vector<uint8_t> reference(int v) const {
+        std::vector<uint8_t> out(ring.size * ring.size, 0);
+        for (int y = 0; y < ring.size; y++) {
+            for (int x = 0; x < ring.size; x++) out[y * ring.size + x] = ring.indicator_at(x, y, v);
+        }
+        return out;
+    }
+
+    Ring ring;
+};
+
+TEST_F(ArcGaugeTest, Ring_CoverageIsAnnulusArea) {
+    double sum = 0;
+    for (int i = 0; i < ring.size * ring.size; i++) sum += ring.coverage[i] / 255.0;
+    const double want = M_PI * (90.0 * 90.0 - 78.0 * 78.0);
+    EXPECT_NEAR(sum, want, want * 0.01);
+
+    // Midden en hoeken leeg, midden van de ringdikte vol
+    EXPECT_EQ(ring.coverage[90 * 180 + 90], 0);
+    EXPECT_EQ(ring.coverage[0], 0);
+    EXPECT_EQ(ring.coverage[90 * 180 + 5], 255);
+}
+
+TEST_F(ArcGaugeTest, Ring_StepsPartitionTheRing) {
+    ASSERT_EQ(ring.begin[0], 0u);
+    ASSERT_EQ(ring.begin[ring.steps], ring.pixels);
+
+    std::vector<bool> seen(ring.size * ring.size, false);
+    for (uint32_t s = 1; s <= ring.steps; s++) {
+        EXPECT_LT(ring.begin[s - 1], ring.begin[s]) << "stap " << s;
+        const Rect& b = ring.box[s - 1];
+        for (uint32_t i = ring.begin[s - 1]; i < ring.begin[s]; i++) {
+            const int p = ring.order[i], x = p % ring.size, y = p / ring.size;
+            ASSERT_FALSE(seen[p]);
+            seen[p] = true;
+            EXPECT_EQ(ring.step_of(x, y), s);
+            EXPECT_TRUE(x >= b.x1 && x <= b.x2 && y >= b.y1 && y <= b.y2) << "stap " << s;
+        }
+    }
+}
+
+TEST_F(ArcGaugeTest, Ring_RotationStartsAtTop) {
+    // Stap 1 ligt net rechts van 12 uur, stap 100 net links ervan
+    const Rect& first = ring.box[0];
+    const Rect& last  = ring.box[ring.steps - 1];
+    EXPECT_GE(first.x1, 89);
+    EXPECT_LT(first.y2, 20);
+    EXPECT_LE(last.x2, 90);
+    EXPECT_LT(last.y2, 20);
+    // Stap 26 begint bij 3 uur
+    EXPECT_GT(ring.box[25].x1, 160);
+}
+
+TEST_F(ArcGaugeTest, Gauge_IncrementalMatchesFullRaster) {
+    Gauge g;
+    ASSERT_TRUE(g.init(ring));
+    std::vector<uint8_t> prev(ring.size * ring.size, 0);
+
+    const int seq[] = { 0, 1, 2, 50, 49, 100, 100, 0, 73, 24, 26, -5, 140, 99 };
+    for (int v : seq) {
+        Rect dirty[Gauge::MAX_DIRTY];
+        const int n = g.set(v, dirty);
+        const int want = v < 0 ? 0 : (v > 100 ? 100 : v);
+        EXPECT_EQ(g.value, want);
+
+        const std::vector<uint8_t> ref = reference(want);
+        ASSERT_EQ(std::memcmp(g.indicator, ref.data(), ref.size()), 0) << "v=" << v;
+        ASSERT_LE(n, Gauge::MAX_DIRTY);
+
+        // Elke gewijzigde pixel valt in een van de rechthoeken
+        uint32_t changed = 0;
+        for (int y = 0; y < ring.size; y++) {
+            for (int x = 0; x < ring.size; x++) {
+                const int p = y * ring.size + x;
+                if (prev[p] == ref[p]) continue;
+                changed++;
+                bool inside = false;
+                for (int i = 0; i < n; i++) {
+                    inside |= x >= dirty[i].x1 && x <= dirty[i].x2 && y >= dirty[i].y1 && y <= dirty[i].y2;
+                }
+                EXPECT_TRUE(inside) << "v=" << v << " (" << x << "," << y << ")";
+            }
+        }
+        EXPECT_LE(changed, g.written);
+        prev = ref;
+    }
+    g.release();
+}
+
+TEST_F(ArcGaugeTest, Gauge_SmallStepTouchesOnlyTheDelta) {
+    Gauge g;
+    ASSERT_TRUE(g.init(ring));
+    Rect dirty[Gauge::MAX_DIRTY];
+    g.set(50, dirty);
+
+    const int n = g.set(52, dirty);
+    ASSERT_EQ(n, 1);
+    // Twee stappen plus het oude en het nieuwe ronde uiteinde (elk een vak van ~(width + 3)^2)
+    EXPECT_GE(g.written, ring.begin[52] - ring.begin[50]);
+    EXPECT_LT(g.written, ring.begin[52] - ring.begin[50] + 2u * 15 * 15);
+    EXPECT_LT(g.written, ring.pixels / 10);
+
+    // Twee stappen van 3,6 graden plus de uiteinden: een smalle strook onderaan, niet de hele ring
+    const int area = (dirty[0].x2 - dirty[0].x1 + 1) * (dirty[0].y2 - dirty[0].y1 + 1);
+    EXPECT_LT(area, 180 * 180 / 50);
+
+    EXPECT_EQ(g.set(52, dirty), 0);
+    EXPECT_EQ(g.written, 0u);
+    g.release();
+}
+
+TEST_F(ArcGaugeTest, Gauge_RoundCapsLikeLvArc) {
+    Gauge g;
+    ASSERT_TRUE(g.init(ring));
+    Rect dirty[Gauge::MAX_DIRTY];
+    g.set(25, dirty);   // einde op 3 uur
+
+    // Midden van de ringdikte (straal 84): het einde steekt een halve dikte voorbij
+    // 3 uur (stap 26), het begin een halve dikte voor 12 uur (stap 100)
+    EXPECT_EQ(g.indicator[90 * 180 + 174], 255);   // 3 uur
+    EXPECT_GT(g.indicator[94 * 180 + 174], 200);   // 4 px voorbij, binnen de kap
+    EXPECT_EQ(g.indicator[100 * 180 + 174], 0);    // 10 px voorbij, erbuiten
+    EXPECT_GT(g.indicator[6 * 180 + 86], 200);     // 4 px links van 12 uur
+    EXPECT_EQ(g.indicator[6 * 180 + 80], 0);
+
+    // Platte hoek van de ring naast de kap: buitenrand op 3 uur + 5 px blijft leeg
+    EXPECT_EQ(g.indicator[95 * 180 + 179], 0);
+
+    // Leeg en vol: geen uiteinden
+    g.set(0, dirty);
+    for (int i = 0; i < 180 * 180; i++) ASSERT_EQ(g.indicator[i], 0) << i;
+    g.set(100, dirty);
+    for (int i = 0; i < 180 * 180; i++) ASSERT_EQ(g.indicator[i], ring.coverage[i]) << i;
+    g.release();
+}
+
+TEST(ArcGauge, Ring_RejectsTooLarge) {
+    Ring r;
+    EXPECT_FALSE(r.init(300, 12, 0, 100));
+    EXPECT_FALSE(r.init(180, 12, 0, 0));
+    EXPECT_EQ(r.coverage, nullptr);
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include "buf_tune.hpp"
+using namespace buftune;
+
+TEST(BufTune, ConfigsCoverTheSweep) {
+  Config c[CONFIG_COUNT];
+  ASSERT_EQ(configs(c), CONFIG_COUNT);
+  EXPECT_EQ(c[0].lines, 4);
+  EXPECT_EQ(c[0].buffers, 1);
+  EXPECT_FALSE(c[0].psram);
+  EXPECT_EQ(c[CONFIG_COUNT - 1].lines, 80);
+  EXPECT_EQ(c[CONFIG_COUNT - 1].buffers, 2);
+  EXPECT_TRUE(c[CONFIG_COUNT - 1].psram);
+
+  EXPECT_EQ(ram_bytes({ 10, 2, false }, 480), 19200u);
+  EXPECT_EQ(ram_bytes({ 80, 1, true }, 480), 76800u);
+}
+
+TEST(BufTune, PicksFastestWhenNothingIsClose) {
+  const Result r[] = {
+    { { 10, 2, false }, true, 9000, 32 },
+    { { 40, 2, false }, true, 6000, 8 },
+    { { 80, 2, false }, true, 7000, 4 },
+  };
+  EXPECT_EQ(recommend(r, 3, 480), 1);
+}
+
+TEST(BufTune, PrefersLessInternalRamWithinTolerance) {
+  const Result r[] = {
+    { { 40, 2, false }, true, 6000, 8 },    // snelste, 76800 B intern
+    { { 20, 2, false }, true, 6200, 16 },   // binnen 5%, 38400 B intern
+    { { 40, 2, true },  true, 6250, 8 },    // binnen 5%, niets intern
+    { { 10, 1, false }, true, 6400, 32 },   // te traag
+  };
+  EXPECT_EQ(recommend(r, 4, 480), 2);
+}
+
+TEST(BufTune, SkipsFailedAllocations) {
+  const Result r[] = {
+    { { 80, 2, false }, false, 0, 0 },
+    { { 10, 2, false }, true, 9000, 32 },
+  };
+  EXPECT_EQ(recommend(r, 2, 480), 1);
+
+  const Result none[] = { { { 80, 2, false }, false, 0, 0 } };
+  EXPECT_EQ(recommend(none, 1, 480), -1);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include "curve_decim.hpp"
+using namespace curvedecim;
+
+// Ontlading van 100 naar 0 met ruis en een paar korte dips (belastingspieken)
+static std::vector<int16_t> makeCurve(uint32_t n) {
+    std::vector<int16_t> y(n);
+    uint32_t seed = 12345;
+    for (uint32_t i = 0; i < n; i++) {
+        seed = seed * 1103515245u + 12345u;
+        const int noise = int((seed >> 16) % 3) - 1;
+        y[i] = int16_t(100 - int64_t(100) * i / n + noise);
+    }
+    for (uint32_t i = n / 7; i < n; i += n / 5) y[i] = -40;
+    return y;
+}
+
+TEST(CurveDecim, MinMax_ShortCurvePassesThrough) {
+    const std::vector<int16_t> y = {98, 95, 93, 92, 91};
+    int32_t out[20];
+    ASSERT_EQ(minmax(y.data(), 0, 5, 10, out), 5u);
+    for (int i = 0; i < 5; i++) EXPECT_EQ(out[i], y[i]);
+}
+
+TEST(CurveDecim, MinMax_KeepsEveryColumnExtreme) {
+    const uint32_t N = 100000, COLS = 310;
+    const std::vector<int16_t> y = makeCurve(N);
+    std::vector<int32_t> out(2 * COLS);
+    ASSERT_EQ(minmax(y.data(), 0, N, COLS, out.data()), 2 * COLS);
+
+    for (uint32_t c = 0; c < COLS; c++) {
+        const uint32_t b = uint32_t(uint64_t(c) * N / COLS);
+        const uint32_t e = uint32_t(uint64_t(c + 1) * N / COLS);
+        const auto imin = std::min_element(y.begin() + b, y.begin() + e);
+        const auto imax = std::max_element(y.begin() + b, y.begin() + e);
+        const int32_t lo = std::min(out[2 * c], out[2 * c + 1]);
+        const int32_t hi = std::max(out[2 * c], out[2 * c + 1]);
+        EXPECT_EQ(lo, *imin) << "kolom " << c;
+        EXPECT_EQ(hi, *imax) << "kolom " << c;
+        // Tijdsvolgorde: wat eerst kwam staat eerst
+        const bool min_first = imin <= imax;
+        EXPECT_EQ(out[2 * c], min_first ? lo : hi) << "kolom " << c;
+    }
+
+    // Alle dips van -40 moeten zichtbaar blijven
+    EXPECT_EQ(std::count(out.begin(), out.end(), -40), 5);
+}
+
+TEST(CurveDecim, MinMax_ZoomWindow) {
+    const std::vector<int16_t> y = makeCurve(10000);
+    std::vector<int32_t> out(20);
+    ASSERT_EQ(minmax(y.data(), 5000, 1000, 10, out.data()), 20u);
+    const auto mm = std::minmax_element(y.begin() + 5000, y.begin() + 5100);
+    EXPECT_EQ(std::min(out[0], out[1]), *mm.first);
+    EXPECT_EQ(std::max(out[0], out[1]), *mm.second);
+}
+
+TEST(CurveDecim, Lttb_EndpointsCountAndOrder) {
+    const uint32_t N = 100000, OUT = 310;
+    const std::vector<int16_t> y = makeCurve(N);
+    std::vector<int32_t> out(OUT);
+    std::vector<uint32_t> idx(OUT);
+    ASSERT_EQ(lttb(y.data(), 0, N, OUT, out.data(), idx.data()), OUT);
+
+    EXPECT_EQ(idx.front(), 0u);
+    EXPECT_EQ(idx.back(), N - 1);
+    for (uint32_t i = 1; i < OUT; i++) EXPECT_LT(idx[i - 1], idx[i]);
+    for (uint32_t i = 0; i < OUT; i++) EXPECT_EQ(out[i], y[idx[i]]);
+
+    // Een dip is de grootste driehoek in zijn bucket en wordt dus gekozen
+    EXPECT_EQ(std::count(out.begin(), out.end(), -40), 5);
+}
+
+TEST(CurveDecim, Lttb_ShortAndDegenerate) {
+    const std::vector<int16_t> y = {10, 20, 30, 40};
+    int32_t out[8];
+    EXPECT_EQ(lttb(y.data(), 0, 4, 8, out), 4u);
+    EXPECT_EQ(out[3], 40);
+    EXPECT_EQ(lttb(y.data(), 0, 4, 2, out), 2u);
+    EXPECT_EQ(out[0], 10);
+    EXPECT_EQ(out[1], 40);
+}
+
+TEST(CurveDecim, Cache_RecomputesOnlyOnChange) {
+    std::vector<int16_t> y = makeCurve(50000);
+    Cache<310> c;
+
+    EXPECT_TRUE(c.update(y.data(), 50000, 1, 0, 0));
+    EXPECT_EQ(c.n, 620u);
+    EXPECT_EQ(c.count, 50000u);
+    EXPECT_FALSE(c.update(y.data(), 50000, 1, 0, 0));
+    EXPECT_FALSE(c.update(y.data(), 50000, 1, 0, 50000));   // zelfde venster na clampen
+
+    EXPECT_TRUE(c.update(y.data(), 50000, 2, 0, 0));        // nieuwe revisie
+    EXPECT_TRUE(c.update(y.data(), 50000, 2, 100, 400));   // zoom
+    EXPECT_EQ(c.first, 100u);
+    EXPECT_EQ(c.count, 400u);
+    EXPECT_EQ(c.n, 400u);                                   // minder dan 2 * 310: ongewijzigd
+    EXPECT_TRUE(c.update(y.data(), 50000, 2, 49900, 1000)); // venster voorbij het eind
+    EXPECT_EQ(c.count, 100u);
+    EXPECT_EQ(c.recomputes, 4u);
+
+    c.reset();
+    EXPECT_TRUE(c.update(y.data(), 50000, 2, 49900, 1000));
+    EXPECT_TRUE(c.update(nullptr, 50000, 2, 0, 0));
+    EXPECT_EQ(c.n, 0u);
+}
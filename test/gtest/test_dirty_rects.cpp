@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "dirty_rects.hpp"
+using namespace dirtyrect;
+
+static constexpr int W = 480, H = 320;
+
+// Per pixel: hoe vaak hij in de rechthoeken valt
+static std::vector<int> coverage(const Rect* r, int n) {
+  std::vector<int> c(W * H, 0);
+  for (int i = 0; i < n; i++) {
+    for (int y = r[i].y1; y <= r[i].y2; y++) {
+      for (int x = r[i].x1; x <= r[i].x2; x++) c[y * W + x]++;
+    }
+  }
+  return c;
+}
+
+TEST(DirtyRects, AdjacentStripesBecomeOne) {
+  Coalescer<8> c;
+  for (int y = 100; y < 160; y += 10) c.add({ 20, (int16_t)y, 200, (int16_t)(y + 9) });
+  ASSERT_EQ(c.coalesce(), 1);
+  EXPECT_EQ(c.rects[0].x1, 20);
+  EXPECT_EQ(c.rects[0].y1, 100);
+  EXPECT_EQ(c.rects[0].x2, 200);
+  EXPECT_EQ(c.rects[0].y2, 159);
+}
+
+TEST(DirtyRects, DistantAreasStaySeparate) {
+  // Twee labels links boven en rechts onder: de omhullende zou bijna het hele scherm zijn
+  Coalescer<8> c;
+  c.add({ 5, 5, 80, 20 });
+  c.add({ 380, 290, 470, 310 });
+  ASSERT_EQ(c.coalesce(), 2);
+  EXPECT_EQ(c.pixels(), 76u * 16 + 91u * 21);
+}
+
+TEST(DirtyRects, ContainedAreaIsDropped) {
+  Coalescer<8> c;
+  c.add({ 0, 0, 99, 99 });
+  c.add({ 10, 10, 20, 20 });
+  EXPECT_EQ(c.count, 1);
+  c.add({ 0, 0, 479, 319 });
+  ASSERT_EQ(c.coalesce(), 1);
+  EXPECT_EQ(c.pixels(), uint32_t(W * H));
+}
+
+TEST(DirtyRects, OverlapIsTrimmed) {
+  // Brede balk en een hoge kolom die er half in steekt: samenvoegen kost te veel,
+  // maar de kolom wordt ingekort zodat geen pixel twee keer verstuurd wordt
+  Coalescer<8> c;
+  c.setup_px = 0;
+  c.add({ 0, 100, 479, 139 });
+  c.add({ 200, 120, 219, 319 });
+  ASSERT_EQ(c.coalesce(), 2);
+
+  const std::vector<int> cov = coverage(c.rects, c.count);
+  for (int y = 120; y <= 319; y++) {
+    for (int x = 200; x <= 219; x++) EXPECT_EQ(cov[y * W + x], 1) << x << "," << y;
+  }
+  EXPECT_EQ(c.pixels(), 480u * 40 + 20u * 180);
+}
+
+TEST(DirtyRects, RandomAreasStayCovered) {
+  uint32_t seed = 12345;
+  auto rnd = [&](int n) { seed = seed * 1103515245u + 12345u; return int((seed >> 8) % n); };
+
+  for (int round = 0; round < 50; round++) {
+    Coalescer<6> c;
+    std::vector<Rect> in;
+    const int n = 1 + rnd(12);
+    for (int i = 0; i < n; i++) {
+      const int x = rnd(W), y = rnd(H);
+      const Rect r = { (int16_t)x, (int16_t)y,
+                       (int16_t)(x + rnd(W - x)), (int16_t)(y + rnd((H - y) < 60 ? H - y : 60)) };
+      in.push_back(r);
+      c.add(r);
+    }
+    const int out = c.coalesce();
+    ASSERT_GE(out, 1);
+    ASSERT_LE(out, 6);
+
+    // Alles wat geïnvalideerd was, gaat mee naar het paneel
+    const std::vector<int> want = coverage(in.data(), (int)in.size());
+    const std::vector<int> got  = coverage(c.rects, out);
+    for (int p = 0; p < W * H; p++) {
+      if (want[p]) {
+        ASSERT_GE(got[p], 1) << "round " << round << " px " << p;
+      }
+    }
+  }
+}
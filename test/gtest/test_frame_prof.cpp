@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "frame_prof.hpp"
+#include "frame_prof_stats.hpp"
+using namespace frameprof;
+
+static FrameRecord makeRecord(uint32_t seq) {
+    FrameRecord r;
+    r.seq = seq;
+    r.t_ms = 1000 + seq * 33;
+    r.inv_areas = uint16_t(3 + seq % 5);
+    r.flushes = uint16_t(seq % 32);
+    r.px_rendered = 4800u * (seq % 32);
+    r.px_pushed = 4800u * (seq % 32) - seq;
+    r.timer_us = 20000 + seq;
+    r.render_us = 12000 + seq;
+    r.flush_us = 15000 + 2 * seq;
+    r.wait_us = 3000 + seq;
+    return r;
+}
+
+static bool sameRecord(const FrameRecord& a, const FrameRecord& b) {
+    return a.seq == b.seq && a.t_ms == b.t_ms && a.inv_areas == b.inv_areas && a.flushes == b.flushes &&
+           a.px_rendered == b.px_rendered && a.px_pushed == b.px_pushed && a.timer_us == b.timer_us &&
+           a.render_us == b.render_us && a.flush_us == b.flush_us && a.wait_us == b.wait_us;
+}
+
+TEST(FrameProf, Ring_FifoAndDropWhenFull) {
+    SpscRing<uint32_t, 4> ring;
+    for (uint32_t i = 0; i < 4; ++i) EXPECT_TRUE(ring.push(i));
+    EXPECT_FALSE(ring.push(99));          // vol: weggooien, niet blokkeren
+    EXPECT_EQ(ring.dropped(), 1u);
+    EXPECT_EQ(ring.size(), 4u);
+
+    uint32_t v;
+    for (uint32_t i = 0; i < 4; ++i) { ASSERT_TRUE(ring.pop(v)); EXPECT_EQ(v, i); }
+    EXPECT_FALSE(ring.pop(v));
+
+    // Index-wrap over de 32-bit teller heen gaat vanzelf goed; hier gewoon veel rondes
+    for (uint32_t i = 0; i < 1000; ++i) { ring.push(i); ASSERT_TRUE(ring.pop(v)); EXPECT_EQ(v, i); }
+}
+
+TEST(FrameProf, Ring_ProducerConsumerThreads) {
+    static SpscRing<FrameRecord, 64> ring;
+    constexpr uint32_t N = 20000;
+
+    std::thread producer([] {
+        for (uint32_t i = 0; i < N; ++i) {
+            while (!ring.push(makeRecord(i))) std::this_thread::yield();
+        }
+    });
+
+    uint32_t expect = 0;
+    FrameRecord r;
+    while (expect < N) {
+        if (!ring.pop(r)) {
+            std::this_thread::yield();   // producer de kern geven (zeker op één core)
+            continue;
+        }
+        ASSERT_TRUE(sameRecord(r, makeRecord(expect)));
+        expect++;
+    }
+    producer.join();
+    EXPECT_EQ(expect, N);   // mislukte pushes tellen als drop, maar elk record kwam aan
+}
+
+TEST(FrameProf, Encode_RoundTrip) {
+    uint8_t buf[RECORD_BYTES];
+    const FrameRecord in = makeRecord(12345);
+    ASSERT_EQ(encode(in, buf), RECORD_BYTES);
+    EXPECT_EQ(RECORD_BYTES, 40u);
+    EXPECT_EQ(buf[0], SYNC0);
+    EXPECT_EQ(buf[1], SYNC1);
+
+    Decoder d;
+    FrameRecord out;
+    int got = 0;
+    for (uint8_t b : buf) got += d.feed(b, out);
+    ASSERT_EQ(got, 1);
+    EXPECT_TRUE(sameRecord(in, out));
+}
+
+TEST(FrameProf, Decoder_SkipsTextAndBadRecords) {
+    std::vector<uint8_t> stream;
+    auto text = [&](const std::string& s) { stream.insert(stream.end(), s.begin(), s.end()); };
+    auto rec = [&](uint32_t seq, bool corrupt) {
+        uint8_t buf[RECORD_BYTES];
+        encode(makeRecord(seq), buf);
+        if (corrupt) buf[10] ^= 0x40;
+        stream.insert(stream.end(), buf, buf + RECORD_BYTES);
+    };
+
+    text("[flush] async render=1200 us\n");
+    rec(1, false);
+    stream.push_back(SYNC0);                 // losse sync-byte in tekst
+    text("[boot] first_pixel=210 ms\n");
+    rec(2, true);
+    rec(3, false);
+
+    Decoder d;
+    std::vector<FrameRecord> out;
+    FrameRecord r;
+    for (uint8_t b : stream) if (d.feed(b, r)) out.push_back(r);
+
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(out[0].seq, 1u);
+    EXPECT_EQ(out[1].seq, 3u);
+    EXPECT_EQ(d.bad(), 1u);
+    EXPECT_GT(d.skipped(), 40u);
+}
+
+TEST(FrameProf, Decoder_TruncatedRecordDoesNotEatTheNext) {
+    std::vector<uint8_t> stream;
+    uint8_t buf[RECORD_BYTES];
+    encode(makeRecord(1), buf);
+    stream.insert(stream.end(), buf, buf + 20);          // afgekapt (reset midden in een record)
+    encode(makeRecord(2), buf);
+    stream.insert(stream.end(), buf, buf + RECORD_BYTES);
+    encode(makeRecord(3), buf);
+    stream.insert(stream.end(), buf, buf + RECORD_BYTES);
+
+    Decoder d;
+    std::vector<FrameRecord> out;
+    FrameRecord r;
+    for (uint8_t b : stream) if (d.feed(b, r)) out.push_back(r);
+
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(out[0].seq, 2u);
+    EXPECT_EQ(out[1].seq, 3u);
+    EXPECT_EQ(d.bad(), 1u);
+}
+
+TEST(FrameProf, Percentiles_NearestRank) {
+    std::vector<uint32_t> v;
+    for (uint32_t i = 1; i <= 100; ++i) v.push_back(101 - i);
+    EXPECT_EQ(percentile(v, 50), 50u);
+    EXPECT_EQ(percentile(v, 90), 90u);
+    EXPECT_EQ(percentile(v, 99), 99u);
+    EXPECT_EQ(percentile(v, 100), 100u);
+    EXPECT_EQ(percentile(v, 0), 1u);
+    EXPECT_EQ(percentile({}, 50), 0u);
+    EXPECT_EQ(percentile({7}, 99), 7u);
+}
+
+TEST(FrameProf, Summary_LostFramesAndFoldedStacks) {
+    std::vector<FrameRecord> recs = { makeRecord(1), makeRecord(2), makeRecord(5) };
+    Summary s = summarize(recs);
+    EXPECT_EQ(s.frames, 3u);
+    EXPECT_EQ(s.lost, 2u);
+
+    auto lines = folded_stacks(s);
+    ASSERT_EQ(lines.size(), 4u);
+    EXPECT_EQ(lines[0], "display_task;lv_timer_handler;render " + std::to_string(s.render_us));
+    const uint64_t other = s.timer_us - s.render_us - s.wait_us;
+    EXPECT_EQ(lines[2], "display_task;lv_timer_handler;other " + std::to_string(other));
+}
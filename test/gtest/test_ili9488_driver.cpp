@@ -0,0 +1,480 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include "ili9488_driver.hpp"
+
+// Helper: LVGL-buffer (RGB565 little endian) met oplopende kleuren
+static std::vector<uint8_t> makeStripe(uint32_t pixels) {
+    std::vector<uint8_t> px(pixels * 2);
+    for (uint32_t i = 0; i < pixels; ++i) {
+        uint16_t c = static_cast<uint16_t>(i * 37u);
+        px[2 * i + 0] = c & 0xFF;
+        px[2 * i + 1] = c >> 8;
+    }
+    return px;
+}
+
+TEST(Ili9488Driver, PushPixels_ByteStream) {
+    auto px = makeStripe(4);
+    LcdBusRegs::reset();
+    ili9488_window().invalidate();
+    ili9488_push_pixels(10, 20, 2, 2, px.data());
+
+    const auto& cyc = LcdBusRegs::state().cycles;
+    ASSERT_EQ(cyc.size(), 11u + 8u);
+
+    // CASET / PASET / RAMWR header (PASET loopt door tot de onderkant, 319)
+    std::vector<uint8_t> hdr = {0x2A, 0, 10, 0, 11, 0x2B, 0, 20, 0x01, 0x3F, 0x2C};
+    for (size_t i = 0; i < hdr.size(); ++i) EXPECT_EQ(cyc[i].data, hdr[i]) << i;
+    EXPECT_FALSE(cyc[0].rs);
+    EXPECT_FALSE(cyc[5].rs);
+    EXPECT_FALSE(cyc[10].rs);
+
+    // Pixels: big endian en geïnverteerd
+    for (uint32_t i = 0; i < 4; ++i) {
+        uint16_t c = static_cast<uint16_t>(~(px[2 * i] | (px[2 * i + 1] << 8)));
+        EXPECT_EQ(cyc[11 + 2 * i].data, c >> 8);
+        EXPECT_EQ(cyc[12 + 2 * i].data, c & 0xFF);
+        EXPECT_TRUE(cyc[11 + 2 * i].rs);
+    }
+}
+
+TEST(Ili9488Driver, PushPixels_TransactionsConstantPerFlush) {
+    // Eén pixel en een volle 480x10 stripe moeten evenveel CS/RS-wissels kosten
+    auto small = makeStripe(1);
+    auto big   = makeStripe(480 * 10);
+
+    LcdBusRegs::reset();
+    ili9488_window().invalidate();
+    ili9488_push_pixels(0, 0, 1, 1, small.data());
+    const uint32_t cs_small = LcdBusRegs::state().cs_toggles;
+    const uint32_t rs_small = LcdBusRegs::state().rs_toggles;
+
+    LcdBusRegs::reset();
+    ili9488_window().invalidate();
+    ili9488_push_pixels(0, 0, 480, 10, big.data());
+    EXPECT_EQ(LcdBusRegs::state().cs_toggles, cs_small);
+    EXPECT_EQ(LcdBusRegs::state().rs_toggles, rs_small);
+
+    EXPECT_EQ(cs_small, 2u);   // 1x laag, 1x hoog
+    EXPECT_EQ(rs_small, 6u);   // CASET, PASET, RAMWR: elk laag + hoog
+}
+
+TEST(Ili9488Driver, LegacyPerByteWrites_ToggleCsEveryByte) {
+    // Ter vergelijking: het oude pad (lcd_writeData per byte) is O(pixels)
+    LcdBusRegs::reset();
+    for (int i = 0; i < 100; ++i) lcd_writeData(0x55);
+    EXPECT_EQ(LcdBusRegs::state().cs_toggles, 200u);
+}
+
+TEST(Ili9488Driver, FillScreen_SingleBurst) {
+    LcdBusRegs::reset();
+    ili9488_window().invalidate();
+    ili9488_fill_screen(0x0000);
+
+    const auto& s = LcdBusRegs::state();
+    EXPECT_EQ(s.cycles.size(), 11u + 320u * 480u * 2u);
+    EXPECT_EQ(s.cs_toggles, 2u);
+    EXPECT_EQ(s.cycles.back().data, 0xFF);   // zwart -> geïnverteerd 0xFFFF
+}
+
+// ---- i80 DMA transport (nep-DMA op de host) ----
+
+using DmaT = I80DmaTransport<lcdbus::FakeDmaEngine>;
+
+// Referentie: pixelbytes zoals het bit-bang pad ze op de bus zet
+static std::vector<uint8_t> bitBangPixelBytes(uint16_t w, uint16_t h, const uint8_t* px) {
+    LcdBusRegs::reset();
+    BitBangTransport::begin_ramwr(0, 0, w, h);
+    BitBangTransport::pixels(px, (uint32_t)w * h);
+    BitBangTransport::end_ramwr();
+    auto b = LcdBusRegs::bytes();
+    return std::vector<uint8_t>(b.begin() + 11, b.end());   // window-header overslaan
+}
+
+TEST(Ili9488Driver, I80Dma_StripeMatchesBitBang) {
+    auto px = makeStripe(480 * 10);
+    auto ref = bitBangPixelBytes(480, 10, px.data());
+
+    DmaT::init();
+    lcdbus::FakeDmaEngine::reset();
+    DmaT::begin_ramwr(0, 0, 480, 10);
+    DmaT::pixels(px.data(), 480 * 10);
+    DmaT::end_ramwr();
+
+    EXPECT_EQ(lcdbus::FakeDmaEngine::color_bytes(), ref);
+
+    // CASET + PASET via CPU, daarna RAMWR + RAMWR-continue
+    const auto& ch = lcdbus::FakeDmaEngine::state().chains;
+    ASSERT_EQ(ch.size(), 4u);
+    EXPECT_EQ(ch[0].cmd, 0x2A);
+    EXPECT_EQ(ch[0].params, (std::vector<uint8_t>{0, 0, 0x01, 0xDF}));
+    EXPECT_EQ(ch[1].cmd, 0x2B);
+    EXPECT_EQ(ch[1].params, (std::vector<uint8_t>{0, 0, 0, 9}));
+    EXPECT_EQ(ch[2].cmd, 0x2C);
+    EXPECT_EQ(ch[3].cmd, 0x3C);
+}
+
+TEST(Ili9488Driver, I80Dma_InitIsIdempotentAndReleasable) {
+    // Backend-wissel (benchmark) roept init opnieuw aan: geen tweede bus, geen nieuwe staging
+    DmaT::init();
+    const int    inits = lcdbus::FakeDmaEngine::state().inits;
+    const size_t bufs  = lcdbus::FakeDmaEngine::state().buffers.size();
+    DmaT::init();
+    EXPECT_EQ(lcdbus::FakeDmaEngine::state().inits, inits);
+    EXPECT_EQ(lcdbus::FakeDmaEngine::state().buffers.size(), bufs);
+
+    // Na deinit (LovyanGFX krijgt de bus) komt de bus terug, de buffers blijven dezelfde
+    DmaT::deinit();
+    DmaT::init();
+    EXPECT_EQ(lcdbus::FakeDmaEngine::state().inits, inits + 1);
+    EXPECT_EQ(lcdbus::FakeDmaEngine::state().buffers.size(), bufs);
+}
+
+TEST(Ili9488Driver, I80Dma_InitFailsWithoutStagingMemory) {
+    // Eigen instantie: staging-buffers nog niet gealloceerd, en het DMA-geheugen is op
+    using NoMemDma = I80DmaTransport<lcdbus::FakeDmaEngine, 12>;
+    lcdbus::FakeDmaEngine::state().fail_alloc = true;
+    EXPECT_FALSE(NoMemDma::init());
+    lcdbus::FakeDmaEngine::state().fail_alloc = false;
+    EXPECT_FALSE(NoMemDma::ready());
+
+    // Pixels vallen weg i.p.v. via een null-pointer geschreven te worden
+    lcdbus::FakeDmaEngine::reset();
+    auto px = makeStripe(20);
+    NoMemDma::begin_ramwr(0, 0, 20, 1);
+    NoMemDma::pixels(px.data(), 20);
+    NoMemDma::color(0xF800, 20);
+    NoMemDma::end_ramwr();
+    EXPECT_TRUE(lcdbus::FakeDmaEngine::color_bytes().empty());
+
+    // Later wel geheugen: de volgende init haalt het alsnog
+    EXPECT_TRUE(NoMemDma::init());
+}
+
+TEST(Ili9488Driver, I80Dma_DescriptorChunking) {
+    auto px = makeStripe(480 * 10);   // 9600 bytes
+
+    DmaT::init();
+    lcdbus::FakeDmaEngine::reset();
+    DmaT::begin_ramwr(0, 0, 480, 10);
+    DmaT::pixels(px.data(), 480 * 10);
+    DmaT::end_ramwr();
+
+    const auto& ch = lcdbus::FakeDmaEngine::state().chains;
+    ASSERT_EQ(ch.size(), 4u);
+
+    // Chunk 1: volle staging-buffer (2 descriptors van 4092), chunk 2: de rest
+    ASSERT_EQ(ch[2].descs.size(), 2u);
+    EXPECT_EQ(ch[2].descs[0].payload.size(), lcdbus::DMA_DESC_MAX);
+    EXPECT_FALSE(ch[2].descs[0].eof);
+    EXPECT_TRUE(ch[2].descs[1].eof);
+    ASSERT_EQ(ch[3].descs.size(), 1u);
+    EXPECT_EQ(ch[3].descs[0].payload.size(), 9600u - ILI9488_I80_CHUNK_BYTES);
+
+    for (const auto& c : ch)
+        for (const auto& d : c.descs) EXPECT_LE(d.payload.size(), lcdbus::DMA_DESC_MAX);
+}
+
+TEST(Ili9488Driver, I80Dma_SplitWritesAndColorMatchBitBang) {
+    // Kleine chunks + pixels in stukken aangeleverd: zelfde bytes als bit-bang
+    using SmallDma = I80DmaTransport<lcdbus::FakeDmaEngine, 10>;
+    auto px = makeStripe(7 * 3);
+    auto ref = bitBangPixelBytes(7, 3, px.data());
+
+    SmallDma::init();
+    lcdbus::FakeDmaEngine::reset();
+    SmallDma::begin_ramwr(0, 0, 7, 3);
+    SmallDma::pixels(px.data(), 4);
+    SmallDma::pixels(px.data() + 8, 17);
+    SmallDma::end_ramwr();
+    EXPECT_EQ(lcdbus::FakeDmaEngine::color_bytes(), ref);
+
+    lcdbus::FakeDmaEngine::reset();
+    SmallDma::begin_ramwr(0, 0, 4, 4);
+    SmallDma::color(0x1234, 16);
+    SmallDma::end_ramwr();
+    auto bytes = lcdbus::FakeDmaEngine::color_bytes();
+    ASSERT_EQ(bytes.size(), 32u);
+    for (size_t i = 0; i < bytes.size(); i += 2) {
+        EXPECT_EQ(bytes[i], 0xED);       // ~0x1234 = 0xEDCB
+        EXPECT_EQ(bytes[i + 1], 0xCB);
+    }
+}
+
+// ---- Native pixelformaat (RGB565_SWAPPED + INVON) ----
+
+TEST(Ili9488Driver, NativePixels_StreamBufferUnchanged) {
+    auto px = makeStripe(480 * 2);
+
+    LcdBusRegs::reset();
+    BitBangTransportT<Rgb565Native>::begin_ramwr(0, 0, 480, 2);
+    BitBangTransportT<Rgb565Native>::pixels(px.data(), 480 * 2);
+    BitBangTransportT<Rgb565Native>::end_ramwr();
+    auto b = LcdBusRegs::bytes();
+    EXPECT_EQ(std::vector<uint8_t>(b.begin() + 11, b.end()), px);
+
+    using NativeDma = I80DmaTransport<lcdbus::FakeDmaEngine, ILI9488_I80_CHUNK_BYTES, Rgb565Native>;
+    NativeDma::init();
+    lcdbus::FakeDmaEngine::reset();
+    NativeDma::begin_ramwr(0, 0, 480, 2);
+    NativeDma::pixels(px.data(), 480 * 2);
+    NativeDma::end_ramwr();
+    EXPECT_EQ(lcdbus::FakeDmaEngine::color_bytes(), px);
+}
+
+TEST(Ili9488Driver, NativePixels_SamePanelColorAsInverted) {
+    // Zelfde logische kleur: inverted-pad stuurt ~c met INVOFF, native stuurt c met INVON.
+    // Wat het paneel toont is in beide gevallen gelijk.
+    for (uint32_t c = 0; c < 0x10000; c += 0x0101) {
+        const uint8_t lo = c & 0xFF, hi = c >> 8;
+        const uint16_t inv = Rgb565Inverted::panel(lo, hi);
+        const uint16_t nat = Rgb565Native::panel(hi, lo);     // SWAPPED buffer: hi eerst
+        EXPECT_EQ(static_cast<uint16_t>(~inv), nat);
+        EXPECT_EQ(Rgb565Inverted::fill(c), inv);
+        EXPECT_EQ(Rgb565Native::fill(c), nat);
+    }
+    EXPECT_EQ(Rgb565Inverted::kInvon, 0x20);
+    EXPECT_EQ(Rgb565Native::kInvon, 0x21);
+}
+
+TEST(Ili9488Driver, WindowTracker_PlansMinimalCommands) {
+    Ili9488WindowTracker t;
+    t.rows = 320;
+
+    auto c = t.plan(0, 0, 480, 10);
+    EXPECT_TRUE(c.caset);
+    EXPECT_TRUE(c.paset);
+    EXPECT_EQ(c.y2, 319);
+    EXPECT_EQ(c.ramwr, 0x2C);
+    t.advance(480 * 10);
+    EXPECT_EQ(t.col, 0);
+    EXPECT_EQ(t.page, 10);
+
+    // Aansluitend: alleen RAMWRC
+    c = t.plan(0, 10, 480, 10);
+    EXPECT_FALSE(c.caset);
+    EXPECT_FALSE(c.paset);
+    EXPECT_EQ(c.ramwr, 0x3C);
+    t.advance(480 * 10);
+
+    // Zelfde kolommen, andere rij: alleen PASET + RAMWR
+    c = t.plan(0, 100, 480, 10);
+    EXPECT_FALSE(c.caset);
+    EXPECT_TRUE(c.paset);
+    EXPECT_EQ(c.ramwr, 0x2C);
+
+    // Half geschreven gebied: pointer staat midden in een rij
+    t.advance(100);
+    EXPECT_EQ(t.col, 100);
+    EXPECT_EQ(t.page, 100);
+
+    // Wrap onderaan het window
+    t.plan(0, 315, 480, 5);
+    t.advance(480 * 5);
+    EXPECT_EQ(t.page, 315);
+}
+
+TEST(Ili9488Driver, I80Dma_ElidedStripeIsSingleContinueTransfer) {
+    auto px = makeStripe(480 * 10);
+    Ili9488WindowTracker t;
+    t.rows = 320;
+
+    DmaT::init();
+    lcdbus::FakeDmaEngine::reset();
+    DmaT::begin_ramwr(t.plan(0, 0, 480, 10));
+    DmaT::pixels(px.data(), 480 * 10);
+    DmaT::end_ramwr();
+    t.advance(480 * 10);
+
+    lcdbus::FakeDmaEngine::reset();
+    DmaT::begin_ramwr(t.plan(0, 10, 480, 10));
+    DmaT::pixels(px.data(), 480 * 10);
+    DmaT::end_ramwr();
+
+    const auto& ch = lcdbus::FakeDmaEngine::state().chains;
+    ASSERT_EQ(ch.size(), 2u);
+    EXPECT_TRUE(ch[0].color);
+    EXPECT_EQ(ch[0].cmd, 0x3C);
+}
+
+// ---- Effen vlakken ----
+
+static std::vector<uint8_t> solidBuf(uint32_t pixels, uint16_t c) {
+    std::vector<uint8_t> px(pixels * 2);
+    for (uint32_t i = 0; i < pixels; ++i) { px[2 * i] = c & 0xFF; px[2 * i + 1] = c >> 8; }
+    return px;
+}
+
+TEST(Ili9488Driver, AreaSolid_DetectsUniformBuffers) {
+    uint16_t c = 0;
+    auto px = solidBuf(480 * 10, 0xEDE1);
+    EXPECT_TRUE(ili9488_area_solid(px.data(), 480 * 10, c));
+    EXPECT_EQ(c, 0xEDE1);
+
+    // Oneven aantal pixels: staartpixel telt mee
+    auto odd = solidBuf(7, 0x1234);
+    EXPECT_TRUE(ili9488_area_solid(odd.data(), 7, c));
+    odd[12] ^= 1;
+    EXPECT_FALSE(ili9488_area_solid(odd.data(), 7, c));
+
+    // Eén afwijkende pixel ergens in het midden van een woord
+    px[2 * 1234 + 1] ^= 0x80;
+    EXPECT_FALSE(ili9488_area_solid(px.data(), 480 * 10, c));
+
+    // Gelijke bytes maar verschoven patroon (0xAB 0xCD 0xCD 0xAB ...)
+    auto swapped = solidBuf(8, 0xCDAB);
+    swapped[2] = 0xCD; swapped[3] = 0xAB;
+    EXPECT_FALSE(ili9488_area_solid(swapped.data(), 8, c));
+
+    EXPECT_FALSE(ili9488_area_solid(px.data(), 0, c));
+}
+
+TEST(Ili9488Driver, SolidArea_WrOnlyStrobesSameBytes) {
+    // Zwart: paneelwoord 0xFFFF, hoge == lage byte -> alleen WR
+    auto black = solidBuf(480 * 10, 0x0000);
+    auto ref   = bitBangPixelBytes(480, 10, black.data());
+
+    LcdBusRegs::reset();
+    ili9488_window().invalidate();
+    ili9488_fill_stats() = {};
+    ili9488_push_pixels(0, 0, 480, 10, black.data());
+
+    auto bytes = LcdBusRegs::bytes();
+    ASSERT_EQ(bytes.size(), 11u + ref.size());
+    EXPECT_TRUE(std::equal(ref.begin(), ref.end(), bytes.begin() + 11));
+
+    const auto& st = ili9488_fill_stats();
+    EXPECT_EQ(st.areas, 1u);
+    EXPECT_EQ(st.solid_areas, 1u);
+    EXPECT_EQ(st.px_solid, 4800u);
+    EXPECT_EQ(st.px_strobe, 4800u);
+    EXPECT_EQ(st.stores_saved(), 9600u);
+}
+
+TEST(Ili9488Driver, SolidArea_MixedBytesStillCorrect) {
+    // Sidebar-geel: hoge en lage byte verschillen, dus gewone writes
+    auto yellow = solidBuf(120 * 10, 0xEDE1);
+    auto ref    = bitBangPixelBytes(120, 10, yellow.data());
+
+    LcdBusRegs::reset();
+    ili9488_window().invalidate();
+    ili9488_fill_stats() = {};
+    ili9488_push_pixels(355, 10, 120, 10, yellow.data());
+
+    auto bytes = LcdBusRegs::bytes();
+    ASSERT_EQ(bytes.size(), 11u + ref.size());
+    EXPECT_TRUE(std::equal(ref.begin(), ref.end(), bytes.begin() + 11));
+    EXPECT_EQ(ili9488_fill_stats().px_solid, 1200u);
+    EXPECT_EQ(ili9488_fill_stats().px_strobe, 0u);
+}
+
+TEST(Ili9488Driver, FillScreen_StoresPerByte) {
+    LcdBusRegs::reset();
+    ili9488_window().invalidate();
+    ili9488_fill_screen(0x0000);
+    const uint32_t strobe_stores = LcdBusRegs::state().stores;
+
+    LcdBusRegs::reset();
+    ili9488_window().invalidate();
+    ili9488_fill_screen(0x1234);             // geen WR-only mogelijk
+    const uint32_t write_stores = LcdBusRegs::state().stores;
+
+    const uint32_t bytes = 480u * 320u * 2u;
+    EXPECT_EQ(write_stores - strobe_stores, bytes - 1);
+}
+
+TEST(Ili9488Driver, I80Dma_SolidColorReusesOneChunk) {
+    // Kleine chunk zodat er meerdere transfers uit één gevulde buffer komen
+    using SmallDma = I80DmaTransport<lcdbus::FakeDmaEngine, 64>;
+    SmallDma::init();
+    lcdbus::FakeDmaEngine::reset();
+
+    SmallDma::begin_ramwr(0, 0, 10, 10);
+    SmallDma::color(0xF800, 100);
+    SmallDma::end_ramwr();
+
+    const auto& ch = lcdbus::FakeDmaEngine::state().chains;
+    ASSERT_EQ(ch.size(), 2u + 4u);           // CASET, PASET, 100 px = 32 + 32 + 32 + 4
+    EXPECT_EQ(ch[2].cmd, 0x2C);
+    for (size_t i = 3; i < ch.size(); ++i) EXPECT_EQ(ch[i].cmd, 0x3C);
+
+    auto bytes = lcdbus::FakeDmaEngine::color_bytes();
+    ASSERT_EQ(bytes.size(), 200u);
+    const uint16_t c = Ili9488PixelFormat::fill(0xF800);
+    for (size_t i = 0; i < bytes.size(); i += 2) {
+        EXPECT_EQ(bytes[i], c >> 8);
+        EXPECT_EQ(bytes[i + 1], c & 0xFF);
+    }
+}
+
+// ---- Init-tabel ----
+
+static_assert(ili9488_init_min_ms() == 125, "SWRESET->SLPOUT 120 ms + SLPOUT 5 ms");
+
+TEST(Ili9488Driver, InitTable_Encoding) {
+    ASSERT_EQ(ILI9488_INIT_STEPS, 5u);
+    const Ili9488InitStep* t = ILI9488_INIT_TABLE;
+
+    EXPECT_EQ(t[0].cmd, 0x01); EXPECT_EQ(t[0].n, 0); EXPECT_EQ(t[0].wait_ms, 120);
+    EXPECT_EQ(t[1].cmd, 0x11); EXPECT_EQ(t[1].n, 0); EXPECT_EQ(t[1].wait_ms, 5);
+    EXPECT_EQ(t[2].cmd, 0x3A); EXPECT_EQ(t[2].n, 1); EXPECT_EQ(t[2].params[0], 0x55);
+    EXPECT_EQ(t[3].cmd, Ili9488PixelFormat::kInvon);
+    EXPECT_EQ(t[4].cmd, 0x29);
+
+    // Tabel-validatie is constexpr: een stap met te veel parameters valt af
+    constexpr Ili9488InitStep bad[] = { { 0x2A, 4, {0, 0, 0}, 0 } };
+    static_assert(!ili9488_init_table_valid(bad, 1), "n > params moet ongeldig zijn");
+    EXPECT_EQ(ili9488_init_min_ms(bad, 1), 0u);
+}
+
+TEST(Ili9488Driver, InitSequencer_SendsOnlyWhenDue) {
+    Ili9488InitSequencer q;
+    LcdBusRegs::reset();
+    q.start(120);
+
+    // Voor de reset-tijd gebeurt er niks
+    EXPECT_FALSE(q.poll(0));
+    EXPECT_EQ(q.wait_ms(0), 120u);
+    EXPECT_TRUE(LcdBusRegs::state().cycles.empty());
+
+    // SWRESET, daarna 120 ms niks
+    EXPECT_FALSE(q.poll(120));
+    ASSERT_EQ(LcdBusRegs::bytes(), (std::vector<uint8_t>{0x01}));
+    EXPECT_FALSE(q.poll(239));
+    EXPECT_EQ(LcdBusRegs::state().cycles.size(), 1u);
+    EXPECT_EQ(q.wait_ms(239), 1u);
+
+    // SLPOUT, daarna 5 ms
+    EXPECT_FALSE(q.poll(240));
+    EXPECT_EQ(LcdBusRegs::state().cycles.size(), 2u);
+    EXPECT_FALSE(q.poll(244));
+
+    // Rest zonder wachttijd in één keer
+    EXPECT_TRUE(q.poll(245));
+    EXPECT_EQ(LcdBusRegs::bytes(),
+              (std::vector<uint8_t>{0x01, 0x11, 0x3A, 0x55, Ili9488PixelFormat::kInvon, 0x29}));
+    EXPECT_TRUE(q.done());
+    EXPECT_EQ(q.wait_ms(1000), 0u);
+}
+
+TEST(Ili9488Driver, InitSequencer_LatePollKeepsMinimumGaps) {
+    // Wie laat pollt, krijgt de wachttijd vanaf het moment van versturen
+    Ili9488InitSequencer q;
+    LcdBusRegs::reset();
+    q.start(0);
+    q.poll(500);                              // SWRESET op t=500
+    EXPECT_EQ(LcdBusRegs::state().cycles.size(), 1u);
+    EXPECT_FALSE(q.poll(619));
+    EXPECT_FALSE(q.poll(620));                // SLPOUT
+    EXPECT_TRUE(q.poll(625));
+}
+
+TEST(Ili9488Driver, Init_BlockingWaitsOnlyTableMinimum) {
+    // Nepklok staat ruim na de power-on reset: init wacht alleen nog de tabel-minima
+    host_millis() = 1000;
+    LcdBusRegs::reset();
+    ili9488_init();
+    EXPECT_EQ(millis() - 1000, ili9488_init_min_ms());
+    EXPECT_TRUE(ili9488_init_poll());
+}
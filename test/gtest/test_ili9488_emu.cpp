@@ -0,0 +1,443 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+#include "ili9488_driver.hpp"
+#include "ili9488_emu.hpp"
+using namespace emu;
+
+// Alles wat de driver sinds de laatste reset op de bus zette, naar de emulator
+static void pump(Ili9488Emu& e) {
+    e.feed(LcdBusRegs::state().cycles);
+    LcdBusRegs::reset();
+}
+
+static std::vector<uint8_t> solid(uint32_t pixels, uint16_t c) {
+    std::vector<uint8_t> px(pixels * 2);
+    for (uint32_t i = 0; i < pixels; ++i) { px[2 * i] = c & 0xFF; px[2 * i + 1] = c >> 8; }
+    return px;
+}
+
+TEST(Ili9488Emu, Init_DecodesCommandSet) {
+    Ili9488Emu e;
+    LcdBusRegs::reset();
+    ili9488_init();
+    pump(e);
+
+    EXPECT_FALSE(e.sleeping());
+    EXPECT_TRUE(e.display_on());
+    EXPECT_EQ(e.colmod(), 0x55);
+    EXPECT_EQ(e.madctl(), 0x28);              // rotatie 1: landscape
+    EXPECT_EQ(e.logical_width(), 480);
+    EXPECT_EQ(e.logical_height(), 320);
+    EXPECT_EQ(e.stats().unknown, 0u);
+}
+
+TEST(Ili9488Emu, PushPixels_VisibleColorMatchesLvgl) {
+    // Driver inverteert in software, glas inverteert terug: zichtbaar = LVGL-kleur
+    Ili9488Emu e;
+    LcdBusRegs::reset();
+    ili9488_init();
+    auto px = solid(20 * 10, 0xF800);         // rood
+    ili9488_push_pixels(100, 50, 20, 10, px.data());
+    pump(e);
+
+    EXPECT_EQ(e.visible_logical(100, 50), 0xF800);
+    EXPECT_EQ(e.visible_logical(119, 59), 0xF800);
+    EXPECT_NE(e.visible_logical(120, 59), 0xF800);
+    EXPECT_NE(e.visible_logical(99, 50), 0xF800);
+    EXPECT_EQ(e.stats().pixels, 200u);
+}
+
+TEST(Ili9488Emu, Rotations_AllFourMapInsideFramebuffer) {
+    for (uint8_t r = 0; r < 4; ++r) {
+        Ili9488Emu e;
+        LcdBusRegs::reset();
+        ili9488_init();
+        ili9488_set_rotation(r);
+        pump(e);
+
+        const int w = e.logical_width(), h = e.logical_height();
+        EXPECT_EQ(w, (r & 1) ? 480 : 320) << int(r);
+
+        // Linkerbovenhoek (logisch) van 2x1 pixels: rood, groen
+        std::vector<uint8_t> px = {0x00, 0xF8, 0xE0, 0x07};
+        ili9488_push_pixels(0, 0, 2, 1, px.data());
+        // Rechteronderhoek: blauw
+        std::vector<uint8_t> pb = {0x1F, 0x00};
+        ili9488_push_pixels(w - 1, h - 1, 1, 1, pb.data());
+        pump(e);
+
+        EXPECT_EQ(e.visible_logical(0, 0), 0xF800) << int(r);
+        EXPECT_EQ(e.visible_logical(1, 0), 0x07E0) << int(r);
+        EXPECT_EQ(e.visible_logical(w - 1, h - 1), 0x001F) << int(r);
+    }
+}
+
+TEST(Ili9488Emu, Rotations_MapToDistinctPhysicalCorners) {
+    // Logisch (0,0) moet per rotatie op een andere fysieke hoek landen
+    const uint8_t madctl[4] = {0x48, 0x28, 0x88, 0xE8};
+    std::vector<std::pair<int, int>> corners;
+    for (uint8_t m : madctl) {
+        Ili9488Emu e;
+        e.command(CMD_MADCTL);
+        e.data(m);
+        int x, y;
+        e.map_address(0, 0, x, y);
+        corners.emplace_back(x, y);
+    }
+    for (size_t i = 0; i < corners.size(); ++i)
+        for (size_t j = i + 1; j < corners.size(); ++j) EXPECT_NE(corners[i], corners[j]);
+}
+
+TEST(Ili9488Emu, Window_WrapsWritePointer) {
+    Ili9488Emu e;
+    e.command(CMD_COLMOD); e.data(0x55);
+    e.command(CMD_CASET); e.data(0); e.data(2); e.data(0); e.data(3);
+    e.command(CMD_PASET); e.data(0); e.data(5); e.data(0); e.data(5);
+    e.command(CMD_RAMWR);
+    for (uint16_t c : {0x1111, 0x2222, 0x3333}) { e.data(c >> 8); e.data(c & 0xFF); }
+
+    // Window is 2x1: derde pixel wrapt terug naar (2,5)
+    EXPECT_EQ(e.raw(2, 5), 0x3333);
+    EXPECT_EQ(e.raw(3, 5), 0x2222);
+
+    // RAMWRC gaat verder waar RAMWR ophield
+    e.command(CMD_RAMWRC);
+    e.data(0x44); e.data(0x44);
+    EXPECT_EQ(e.raw(3, 5), 0x4444);
+}
+
+TEST(Ili9488Emu, InvonAndNativePixels_ShowSameImage) {
+    // Native-pixelmodus: SWAPPED-buffer + INVON moet hetzelfde beeld geven
+    Ili9488Emu e;
+    LcdBusRegs::reset();
+    ili9488_init();
+    lcd_txBegin(); lcd_txCommand(0x21); lcd_txEnd();   // INVON
+    std::vector<uint8_t> px = {0xF8, 0x00};            // rood, big endian
+    BitBangTransportT<Rgb565Native>::begin_ramwr(7, 7, 1, 1);
+    BitBangTransportT<Rgb565Native>::pixels(px.data(), 1);
+    BitBangTransportT<Rgb565Native>::end_ramwr();
+    pump(e);
+
+    EXPECT_TRUE(e.inverted());
+    EXPECT_EQ(e.visible_logical(7, 7), 0xF800);
+}
+
+TEST(Ili9488Emu, Timing_WrCyclesAtClock) {
+    Ili9488Emu e(10000000);   // 10 MHz WR
+    LcdBusRegs::reset();
+    ili9488_init();
+    pump(e);
+    e.reset_stats();
+
+    auto px = solid(480 * 10, 0);
+    ili9488_push_pixels(0, 0, 480, 10, px.data());
+    pump(e);
+
+    // 11 header-bytes + 2 bytes per pixel, 100 ns per byte
+    EXPECT_EQ(e.stats().wr_cycles, 11u + 9600u);
+    EXPECT_NEAR(e.bus_us(), (11 + 9600) * 0.1, 1e-6);
+}
+
+TEST(Ili9488Emu, Dump_PpmAndPngHeaders) {
+    Ili9488Emu e;
+    e.command(CMD_MADCTL); e.data(0x28);
+
+    const std::string ppm = ::testing::TempDir() + "emu.ppm";
+    const std::string png = ::testing::TempDir() + "emu.png";
+    ASSERT_TRUE(e.write_ppm(ppm));
+    ASSERT_TRUE(e.write_png(png));
+
+    FILE* f = std::fopen(ppm.c_str(), "rb");
+    ASSERT_NE(f, nullptr);
+    char hdr[16] = {};
+    ASSERT_EQ(std::fread(hdr, 1, 14, f), 14u);
+    std::fclose(f);
+    EXPECT_EQ(std::string(hdr, 14), "P6\n480 320\n255");
+
+    f = std::fopen(png.c_str(), "rb");
+    ASSERT_NE(f, nullptr);
+    uint8_t sig[24] = {};
+    ASSERT_EQ(std::fread(sig, 1, 24, f), 24u);
+    std::fclose(f);
+    EXPECT_EQ(sig[1], 'P');
+    EXPECT_EQ((sig[16] << 24 | sig[17] << 16 | sig[18] << 8 | sig[19]), 480);
+    EXPECT_EQ((sig[20] << 24 | sig[21] << 16 | sig[22] << 8 | sig[23]), 320);
+}
+
+// ---- Set-window elisie voor aansluitende stripes ----
+
+// Random gevulde stripe
+static std::vector<uint8_t> noise(uint32_t pixels, uint32_t seed) {
+    std::vector<uint8_t> px(pixels * 2);
+    for (auto& b : px) { seed = seed * 1103515245u + 12345u; b = uint8_t(seed >> 16); }
+    return px;
+}
+
+struct Area { uint16_t x, y, w, h; };
+
+// Zelfde gebieden via de driver (met elisie) en via volledige windows (referentie)
+static void renderBoth(const std::vector<Area>& areas, Ili9488Emu& withElide, Ili9488Emu& reference,
+                       uint64_t& bytesElide, uint64_t& bytesRef) {
+    LcdBusRegs::reset();
+    ili9488_init();
+    pump(withElide);
+    LcdBusRegs::reset();
+    ili9488_init();
+    pump(reference);
+    withElide.reset_stats();
+    reference.reset_stats();
+
+    uint32_t seed = 1;
+    for (const Area& a : areas) {
+        auto px = noise(uint32_t(a.w) * a.h, seed++);
+
+        ili9488_push_pixels(a.x, a.y, a.w, a.h, px.data());
+        pump(withElide);
+
+        BitBangTransport::begin_ramwr(a.x, a.y, a.w, a.h);
+        BitBangTransport::pixels(px.data(), uint32_t(a.w) * a.h);
+        BitBangTransport::end_ramwr();
+        pump(reference);
+    }
+    bytesElide = withElide.stats().wr_cycles;
+    bytesRef   = reference.stats().wr_cycles;
+}
+
+TEST(Ili9488Emu, WindowElision_FullFrameStripesIdentical) {
+    // LVGL PARTIAL met 10-lijns buffers: 32 stripes van 480x10
+    std::vector<Area> areas;
+    for (uint16_t y = 0; y < 320; y += 10) areas.push_back({0, y, 480, 10});
+
+    Ili9488Emu a, b;
+    uint64_t ba = 0, bb = 0;
+    renderBoth(areas, a, b, ba, bb);
+
+    EXPECT_EQ(a.framebuffer(), b.framebuffer());
+    // Eerste stripe volledige header (11), daarna alleen RAMWRC (1)
+    EXPECT_EQ(bb - ba, 31u * 10u);
+    EXPECT_EQ(a.stats().windows, 1u);
+}
+
+TEST(Ili9488Emu, WindowElision_MixedAreasIdentical) {
+    // Stripes met gaten, andere breedtes, herstart bovenaan, stukje onderaan
+    std::vector<Area> areas = {
+        {0, 0, 480, 10}, {0, 10, 480, 10}, {0, 30, 480, 10},     // gat: opnieuw PASET
+        {30, 25, 310, 10}, {30, 35, 310, 10}, {30, 45, 310, 5},  // chart-kolom
+        {355, 10, 120, 10}, {355, 20, 120, 10},                  // sidebar
+        {0, 0, 480, 10}, {0, 10, 480, 10},                       // volgende frame
+        {0, 315, 480, 5}, {0, 0, 480, 10},                       // onderrand, dan wrap
+    };
+
+    Ili9488Emu a, b;
+    uint64_t ba = 0, bb = 0;
+    renderBoth(areas, a, b, ba, bb);
+
+    EXPECT_EQ(a.framebuffer(), b.framebuffer());
+    EXPECT_LT(ba, bb);
+}
+
+TEST(Ili9488Emu, WindowElision_RotationInvalidates) {
+    auto px = noise(480 * 10, 7);
+    LcdBusRegs::reset();
+    ili9488_init();
+    ili9488_push_pixels(0, 0, 480, 10, px.data());
+    ili9488_set_rotation(1);
+    LcdBusRegs::reset();
+    ili9488_push_pixels(0, 10, 480, 10, px.data());
+
+    // Na een MADCTL-write wordt het window opnieuw volledig gezet
+    EXPECT_EQ(LcdBusRegs::state().cycles.front().data, 0x2A);
+}
+
+TEST(Ili9488Emu, SolidFill_SameImageAsStreaming) {
+    // Zwart (WR-only) en geel (gewone writes) via het effen-pad vs gestreamd
+    Ili9488Emu a, b;
+    LcdBusRegs::reset();
+    ili9488_init();
+    pump(a);
+    LcdBusRegs::reset();
+    ili9488_init();
+    pump(b);
+
+    const uint16_t colors[] = {0x0000, 0xEDE1, 0xFFFF};
+    uint16_t y = 0;
+    for (uint16_t c : colors) {
+        auto px = solid(480 * 10, c);
+        ili9488_push_pixels(0, y, 480, 10, px.data());
+        pump(a);
+
+        BitBangTransport::begin_ramwr(0, y, 480, 10);
+        BitBangTransport::pixels(px.data(), 480 * 10);
+        BitBangTransport::end_ramwr();
+        pump(b);
+        y += 10;
+    }
+
+    EXPECT_EQ(a.framebuffer(), b.framebuffer());
+    EXPECT_EQ(a.visible_logical(0, 0), 0x0000);
+    EXPECT_EQ(a.visible_logical(479, 15), 0xEDE1);
+    EXPECT_EQ(a.visible_logical(200, 29), 0xFFFF);
+}
+
+// ---- Hardware vertical scroll / strip-chart ----
+#include "ili9488_strip_chart.hpp"
+
+TEST(Ili9488Emu, Scroll_DecodesDefinitionAndStart) {
+    Ili9488Emu e;
+    LcdBusRegs::reset();
+    ili9488_init();
+    ili9488_scroll_define(30, 310, 140);
+    ili9488_scroll_start(100);
+    pump(e);
+
+    EXPECT_TRUE(e.scrolling());
+    EXPECT_EQ(e.scroll_tfa(), 30);
+    EXPECT_EQ(e.scroll_vsa(), 310);
+    EXPECT_EQ(e.scroll_bfa(), 140);
+    EXPECT_EQ(e.scroll_vsp(), 100);
+    EXPECT_EQ(e.scanout_row(10), 10);          // vaste bovenzone
+    EXPECT_EQ(e.scanout_row(30), 100);         // eerste lijn scrollgebied = VSP
+    EXPECT_EQ(e.scanout_row(269), 339);
+    EXPECT_EQ(e.scanout_row(270), 30);         // wrap binnen het scrollgebied
+    EXPECT_EQ(e.scanout_row(400), 400);        // vaste onderzone
+    EXPECT_EQ(e.stats().unknown, 0u);
+
+    ili9488_scroll_off();
+    pump(e);
+    EXPECT_FALSE(e.scrolling());
+    EXPECT_EQ(e.scanout_row(30), 30);
+}
+
+TEST(Ili9488Emu, StripChart_ScrolledFramebufferShowsLatestSamples) {
+    constexpr uint16_t X0 = 30, W = 310, Y0 = 26, H = 178;
+    const uint16_t FG = 0xEDE1, BG = 0x0000;
+
+    Ili9488Emu e;
+    LcdBusRegs::reset();
+    ili9488_init();
+
+    // Iets buiten de band dat niet mag bewegen
+    auto red = solid(20 * 20, 0xF800);
+    ili9488_push_pixels(400, 100, 20, 20, red.data());
+
+    Ili9488StripChart strip;
+    strip.begin(X0, W, Y0, H, FG, BG);
+
+    // Meer samples dan de band breed is: het geheugen wrapt, het beeld schuift
+    constexpr int N = 500;
+    std::vector<int16_t> ys;
+    for (int k = 0; k < N; ++k) {
+        const int32_t v = (k * 37) % 5000;
+        ys.push_back(strip.y_of(v, 0, 5000));
+        strip.push(v, 0, 5000);
+    }
+    pump(e);
+
+    EXPECT_EQ(e.scroll_vsp(), X0 + strip.head);
+
+    // Schermkolom X0 + j toont sample N - W + j, met een lijn naar de vorige sample
+    for (int j = 0; j < W; ++j) {
+        const int k = N - W + j;
+        const int top = std::min(ys[k], ys[k - 1]);
+        const int bot = std::max(ys[k], ys[k - 1]);
+        for (int y = Y0; y < Y0 + H; ++y) {
+            const uint16_t want = (y >= top && y <= bot) ? FG : BG;
+            ASSERT_EQ(e.visible_logical(X0 + j, y), want) << "x=" << X0 + j << " y=" << y;
+        }
+    }
+
+    // Buiten de band staat alles stil
+    EXPECT_EQ(e.visible_logical(400, 100), 0xF800);
+    EXPECT_EQ(e.visible_logical(419, 119), 0xF800);
+}
+
+TEST(Ili9488Emu, StripChart_SampleCostIsOneColumn) {
+    Ili9488Emu e;
+    LcdBusRegs::reset();
+    ili9488_init();
+    Ili9488StripChart strip;
+    strip.begin(30, 310, 26, 178, 0xFFFF, 0x0000);
+    strip.push(100, 0, 5000);
+    pump(e);
+
+    e.reset_stats();
+    strip.push(200, 0, 5000);
+    pump(e);
+
+    // Eén kolom van het plotgebied + window + VSCRSADD, tegen 310x180 pixels voor een repaint
+    EXPECT_EQ(e.stats().pixels, 178u);
+    EXPECT_EQ(e.stats().windows, 1u);
+    EXPECT_LT(e.stats().wr_cycles, 178u * 2u + 16u);
+    EXPECT_LT(e.stats().wr_cycles * 100, 310u * 180u * 2u);
+}
+
+TEST(Ili9488Emu, StripChart_PushAroundSkipsPlotOnly) {
+    Ili9488Emu e;
+    LcdBusRegs::reset();
+    ili9488_init();
+    Ili9488StripChart strip;
+    strip.begin(30, 310, 26, 178, 0xFFFF, 0x0000);
+    strip.push(2500, 0, 5000);
+    pump(e);
+
+    // LVGL-vlak over de hele breedte, rijen 20..39: de plotrijen 26..39 in de band
+    // zijn van de strip, de rest bereikt het paneel
+    e.reset_stats();
+    auto blue = solid(480 * 20, 0x001F);
+    strip.push_around(0, 20, 480, 20, blue.data());
+    pump(e);
+
+    for (int x : { 0, 29, 30, 200, 339, 340, 479 }) {
+        EXPECT_EQ(e.visible_logical(x, 20), 0x001F) << x;
+        EXPECT_EQ(e.visible_logical(x, 25), 0x001F) << x;
+    }
+    EXPECT_EQ(e.visible_logical(0, 39), 0x001F);
+    EXPECT_EQ(e.visible_logical(479, 39), 0x001F);
+    for (int x : { 30, 200, 339 }) {
+        EXPECT_EQ(e.visible_logical(x, 26), 0x0000) << x;
+        EXPECT_EQ(e.visible_logical(x, 39), 0x0000) << x;
+    }
+
+    // Links, rechts en de geschoven band (wrapt één keer): vier vensters, niet één per rij
+    EXPECT_EQ(e.stats().windows, 4u);
+    EXPECT_EQ(e.stats().pixels, 30u * 20 + 140u * 20 + 310u * 6);
+}
+
+TEST(Ili9488Emu, StripChart_LabelsStayInPlace) {
+    constexpr uint16_t X0 = 30, W = 310, Y0 = 26, H = 178;
+    Ili9488Emu e;
+    LcdBusRegs::reset();
+    ili9488_init();
+
+    // Label onder de chart, in de band: 40x12 met een herkenbaar patroon
+    constexpr uint16_t LX = 100, LY = 220, LW = 40, LH = 12;
+    std::vector<uint8_t> label(LW * LH * 2);
+    for (uint32_t i = 0; i < LW * LH; ++i) {
+        const uint16_t c = uint16_t(i * 2654435761u >> 16);
+        label[2 * i] = c & 0xFF; label[2 * i + 1] = c >> 8;
+    }
+    auto check = [&](const char* when) {
+        for (uint16_t r = 0; r < LH; ++r) {
+            for (uint16_t c = 0; c < LW; ++c) {
+                const uint16_t want = label[2 * (r * LW + c)] | (label[2 * (r * LW + c) + 1] << 8);
+                ASSERT_EQ(e.visible_logical(LX + c, LY + r), want) << when << " " << c << "," << r;
+            }
+        }
+    };
+
+    Ili9488StripChart strip;
+    ili9488_push_pixels(LX, LY, LW, LH, label.data());
+    strip.begin(X0, W, Y0, H, 0xFFFF, 0x0000);
+    pump(e);
+    check("begin");
+
+    // Na elke sample tekent LVGL het label opnieuw (de caller invalideert de band)
+    for (int k = 0; k < 400; ++k) {
+        strip.push((k * 53) % 5000, 0, 5000);
+        strip.push_around(LX, LY, LW, LH, label.data());
+    }
+    pump(e);
+    check("na 400 samples");
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "lcd_bus.hpp"
+#include "lcd_bus_fake.hpp"
+using namespace lcdbus;
+
+// Zelfde pinning als het echte PCB (D0..D7 = 10..17, WR = 20, RS = 45, CS = 2)
+struct TestPins {
+    static constexpr int D0 = 10;
+    static constexpr int WR = 20;
+    static constexpr int RS = 45;
+    static constexpr int CS = 2;
+};
+
+using Regs = FakeGpioRegs<TestPins>;
+using Bus  = ParallelBus8<TestPins, Regs>;
+
+TEST(LcdBus, Masks_CompileTime) {
+    static_assert(Bus::DATA_MASK == 0x0003FC00u, "D0..D7 op GPIO10..17");
+    static_assert(Bus::WR_MASK   == (1u << 20),  "WR op GPIO20");
+    static_assert(bank_of(45) == 1 && mask_of(45) == (1u << 13), "RS in bank 1");
+    SUCCEED();
+}
+
+TEST(LcdBus, Write_LatchesEveryByteValue) {
+    Regs::reset();
+    Bus::idle();
+    Bus::rs_data();
+    Bus::cs_low();
+    for (int v = 0; v < 256; ++v) Bus::write(static_cast<uint8_t>(v));
+    Bus::cs_high();
+
+    auto b = Regs::bytes();
+    ASSERT_EQ(b.size(), 256u);
+    for (int v = 0; v < 256; ++v) EXPECT_EQ(b[v], v);
+    for (const auto& c : Regs::state().cycles) EXPECT_TRUE(c.rs);
+}
+
+TEST(LcdBus, Write_CostsThreeStoresPerByte) {
+    Regs::reset();
+    Bus::cs_low();
+    const uint32_t before = Regs::state().stores;
+    Bus::write(0xA5);
+    Bus::write(0x5A);
+    EXPECT_EQ(Regs::state().stores - before, 6u);
+}
+
+TEST(LcdBus, Strobe_RepeatsLastByte) {
+    Regs::reset();
+    Bus::cs_low();
+    Bus::write(0x3C);
+    Bus::strobe();
+    Bus::strobe();
+    EXPECT_EQ(Regs::bytes(), (std::vector<uint8_t>{0x3C, 0x3C, 0x3C}));
+}
+
+TEST(LcdBus, CommandVsData_RsLevel) {
+    Regs::reset();
+    Bus::cs_low();
+    Bus::rs_command();
+    Bus::write(0x2C);
+    Bus::rs_data();
+    Bus::write(0x12);
+    ASSERT_EQ(Regs::state().cycles.size(), 2u);
+    EXPECT_FALSE(Regs::state().cycles[0].rs);
+    EXPECT_TRUE(Regs::state().cycles[1].rs);
+}
+
+TEST(LcdBus, CsHigh_IgnoresWrEdges) {
+    Regs::reset();
+    Bus::idle();               // CS hoog
+    Bus::write(0x77);
+    EXPECT_TRUE(Regs::bytes().empty());
+}
@@ -0,0 +1,26 @@
+#include <gtest/gtest.h>
+#include "ui_bind.hpp"
+using namespace uibind;
+
+TEST(UiBind, Quantize_DisplayResolution) {
+    EXPECT_EQ(quantize(1.234f, 100), 123);
+    EXPECT_EQ(quantize(1.236f, 100), 124);
+    EXPECT_EQ(quantize(-0.004f, 100), 0);
+    EXPECT_EQ(quantize(-1.25f, 10), -13);   // weg van nul, zoals lroundf
+    EXPECT_EQ(quantize(59.4f, 1), 59);
+}
+
+TEST(UiBind, Field_OnlyChangesWhenQuantizedValueChanges) {
+    Field f;
+    stats() = {};
+    EXPECT_TRUE(f.set(quantize(1.00f, 100)));    // eerste keer altijd
+    EXPECT_FALSE(f.set(quantize(1.001f, 100)));  // zelfde tekst "1.00"
+    EXPECT_FALSE(f.set(quantize(0.996f, 100)));
+    EXPECT_TRUE(f.set(quantize(1.006f, 100)));
+    EXPECT_EQ(f.shown, 101);
+    EXPECT_EQ(stats().fields, 4u);
+    EXPECT_EQ(stats().changed, 2u);
+
+    f.reset();                                    // widget opnieuw aangemaakt
+    EXPECT_TRUE(f.set(101));
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "ui_fmt.hpp"
+using namespace uifmt;
+
+// Referentie: snprintf("%*.*f") op v / 10^in_dec. Een exacte .5 is in double
+// meestal net niet exact, dus een duwtje van 1e-9 van nul af geeft dezelfde
+// half-van-nul-af afronding als fixed() (ver onder de kleinste stap van 1e-9
+// bij 9 decimalen zou dit misgaan, daarom gaan de tests tot 6 decimalen).
+static std::string ref_fixed(int32_t v, int in_dec, int dec, int width = 0) {
+    double d = v / std::pow(10.0, in_dec);
+    d += std::copysign(1e-9, d);
+    char buf[64];
+    std::snprintf(buf, sizeof(buf), "%*.*f", width, dec, d);
+    std::string s = buf;
+    // fixed() schrijft geen "-0.00": een negatieve waarde die op nul uitkomt is nul
+    const size_t minus = s.find('-');
+    if (minus != std::string::npos && s.find_first_not_of("-0. ", 0) == std::string::npos) {
+        s.erase(minus, 1);
+        if (width > 0 && (int)s.size() < width) s.insert(0, " ");
+    }
+    return s;
+}
+
+static std::string got_fixed(int32_t v, int in_dec, int dec, int width = 0) {
+    char buf[64];
+    const size_t n = fixed(buf, sizeof(buf), v, (uint8_t)in_dec, (uint8_t)dec, (uint8_t)width);
+    EXPECT_EQ(n, std::string(buf).size());
+    return buf;
+}
+
+// mV -> "V.VV": elke millivolt van -1000 V tot +1000 V
+TEST(UiFmt, Fixed_MillivoltsToCentivolts_Exhaustive) {
+    for (int32_t v = -1000000; v <= 1000000; v++) {
+        ASSERT_EQ(got_fixed(v, 3, 2), ref_fixed(v, 3, 2)) << "v=" << v;
+    }
+}
+
+// Al op displayresolutie (zoals uibind::quantize(v, 100)) en zonder afronding
+TEST(UiFmt, Fixed_SameScale_Exhaustive) {
+    for (int32_t v = -1000000; v <= 1000000; v++) {
+        ASSERT_EQ(got_fixed(v, 2, 2), ref_fixed(v, 2, 2)) << "v=" << v;
+    }
+}
+
+// Alle combinaties van in- en uitvoerdecimalen, plus de int32-randen
+TEST(UiFmt, Fixed_AllScales) {
+    const int32_t vals[] = { 0, 1, -1, 5, -5, 49, 50, -50, 95, 999, 1000, 1499, 1500, -1500,
+                             123456, -987654, 2147483647, -2147483647 - 1 };
+    for (int in_dec = 0; in_dec <= 6; in_dec++) {
+        for (int dec = 0; dec <= 6; dec++) {
+            for (int32_t v : vals) {
+                ASSERT_EQ(got_fixed(v, in_dec, dec), ref_fixed(v, in_dec, dec))
+                    << "v=" << v << " in_dec=" << in_dec << " dec=" << dec;
+            }
+        }
+    }
+}
+
+TEST(UiFmt, Fixed_Width) {
+    for (int width = 0; width <= 10; width++) {
+        for (int32_t v = -20000; v <= 20000; v += 7) {
+            ASSERT_EQ(got_fixed(v, 3, 2, width), ref_fixed(v, 3, 2, width))
+                << "v=" << v << " width=" << width;
+        }
+    }
+}
+
+TEST(UiFmt, Fixed_NegativeRoundingToZero) {
+    EXPECT_EQ(got_fixed(-4, 3, 2), "0.00");
+    EXPECT_EQ(got_fixed(-5, 3, 2), "-0.01");
+    EXPECT_EQ(got_fixed(-4, 3, 2, 6), "  0.00");
+}
+
+TEST(UiFmt, Mmss_Exhaustive) {
+    char got[32], want[32];
+    for (uint32_t s = 0; s <= 100u * 3600u; s++) {
+        mmss(got, sizeof(got), s);
+        std::snprintf(want, sizeof(want), "%02u:%02u", (unsigned)(s / 60), (unsigned)(s % 60));
+        ASSERT_STREQ(got, want) << "s=" << s;
+    }
+}
+
+// Afkappen zoals snprintf: altijd nul-afgesloten, lengte = wat het had moeten worden
+TEST(UiFmt, Writer_TruncatesLikeSnprintf) {
+    for (size_t n = 0; n <= 24; n++) {
+        char got[32], want[32];
+        std::memset(got, 'x', sizeof(got));
+        std::memset(want, 'x', sizeof(want));
+        const size_t len = Writer(got, n).str("Voltage = ").fixed(12345, 3, 2).str(" V").len();
+        const int wlen = std::snprintf(want, n, "Voltage = %.2f V", 12.35);
+        EXPECT_EQ(len, (size_t)wlen) << "n=" << n;
+        EXPECT_EQ(std::memcmp(got, want, sizeof(got)), 0) << "n=" << n;
+    }
+}
+
+TEST(UiFmt, Writer_Composes) {
+    char buf[48];
+    Writer w(buf, sizeof(buf));
+    w.str("Run-time = ").mmss(125).str(" / ").fixed(-1234, 3, 1).ch('V');
+    EXPECT_STREQ(buf, "Run-time = 02:05 / -1.2V");
+    EXPECT_FALSE(w.truncated());
+}
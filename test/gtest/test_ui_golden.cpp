@@ -0,0 +1,301 @@
+// test_ui_golden.cpp - golden-image regressie voor UI1/2/3 (echte LVGL, host-display)
+//
+// Per scherm: een paar gescripte modeltoestanden renderen en pixel voor pixel
+// vergelijken met golden/<naam>.ppm. Bij een verschil komen <naam>.actual.ppm en
+// <naam>.diff.ppm in golden_out/ van de build-map. Daarnaast wordt per model-tick
+// vastgelegd hoeveel gebieden en pixels er geflusht worden (golden/<ui>.updates):
+// een update die meer van het scherm invalideert faalt ook als de pixels kloppen.
+//
+// Een ontbrekende referentie is een fout; golden/ wordt alleen geschreven met
+// UPDATE_GOLDEN=1 ctest -R UiGolden. Zonder enige referentie (UI_GOLDEN_HELD_BACK,
+// gezet door CMake) worden de UiGolden-tests overgeslagen tot ze vastgelegd zijn.
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <lvgl.h>
+
+#include "host_display.hpp"
+#include "ui_screens.hpp"
+#include "ui_gauge.hpp"
+#include "demo_model.hpp"
+
+static HostDisplay g_disp;
+
+class LvglEnv : public ::testing::Environment {
+public:
+    void SetUp() override {
+        lv_init();
+        lv_tick_set_cb(host_tick_ms);
+        g_disp.create();
+    }
+};
+
+static ::testing::Environment* const lvgl_env = ::testing::AddGlobalTestEnvironment(new LvglEnv);
+
+static bool update_golden() {
+    const char* v = std::getenv("UPDATE_GOLDEN");
+    return v && v[0] == '1';
+}
+
+// Nog niets vastgelegd: overslaan i.p.v. elke vergelijking laten falen
+static bool held_back() {
+    return UI_GOLDEN_HELD_BACK && !update_golden();
+}
+
+static std::string golden_path(const std::string& name) {
+    return std::string(UI_GOLDEN_DIR) + "/" + name;
+}
+
+// Actual- en diff-beelden: in de build-map, nooit in de source tree
+static std::string out_path(const std::string& name) {
+    return std::string(UI_GOLDEN_OUT_DIR) + "/" + name;
+}
+
+// ---- PPM (P6) lezen/schrijven ----
+
+static std::vector<uint8_t> to_rgb(const std::vector<uint16_t>& fb) {
+    std::vector<uint8_t> rgb(fb.size() * 3);
+    for (size_t i = 0; i < fb.size(); i++) {
+        rgb[3 * i + 0] = static_cast<uint8_t>(((fb[i] >> 11) & 0x1F) * 255 / 31);
+        rgb[3 * i + 1] = static_cast<uint8_t>(((fb[i] >> 5) & 0x3F) * 255 / 63);
+        rgb[3 * i + 2] = static_cast<uint8_t>((fb[i] & 0x1F) * 255 / 31);
+    }
+    return rgb;
+}
+
+static bool write_ppm(const std::string& path, const std::vector<uint8_t>& rgb, int w, int h) {
+    FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    std::fprintf(f, "P6\n%d %d\n255\n", w, h);
+    std::fwrite(rgb.data(), 1, rgb.size(), f);
+    std::fclose(f);
+    return true;
+}
+
+static bool read_ppm(const std::string& path, std::vector<uint8_t>& rgb, int& w, int& h) {
+    FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return false;
+    int maxval = 0;
+    const bool ok = std::fscanf(f, "P6 %d %d %d", &w, &h, &maxval) == 3 && maxval == 255 && std::fgetc(f) != EOF;
+    if (ok) {
+        rgb.resize(static_cast<size_t>(w) * h * 3);
+        const bool full = std::fread(rgb.data(), 1, rgb.size(), f) == rgb.size();
+        std::fclose(f);
+        return full;
+    }
+    std::fclose(f);
+    return false;
+}
+
+// Verschillen rood op een gedimde grijze versie van de referentie
+static std::vector<uint8_t> diff_image(const std::vector<uint8_t>& want, const std::vector<uint8_t>& got) {
+    std::vector<uint8_t> out(want.size());
+    for (size_t i = 0; i < want.size(); i += 3) {
+        const bool differs = want[i] != got[i] || want[i + 1] != got[i + 1] || want[i + 2] != got[i + 2];
+        if (differs) {
+            out[i] = 255; out[i + 1] = 0; out[i + 2] = 0;
+        } else {
+            const uint8_t g = static_cast<uint8_t>((want[i] + want[i + 1] + want[i + 2]) / 12);
+            out[i] = out[i + 1] = out[i + 2] = g;
+        }
+    }
+    return out;
+}
+
+static void expect_matches_golden(const std::string& name) {
+    const int W = HostDisplay::WIDTH, H = HostDisplay::HEIGHT;
+    const std::vector<uint8_t> got = to_rgb(g_disp.fb);
+    const std::string path = golden_path(name + ".ppm");
+
+    if (update_golden()) {
+        ASSERT_TRUE(write_ppm(path, got, W, H)) << path;
+        std::printf("golden vastgelegd: %s\n", path.c_str());
+        return;
+    }
+    std::vector<uint8_t> want;
+    int w = 0, h = 0;
+    if (!read_ppm(path, want, w, h)) {
+        write_ppm(out_path(name + ".actual.ppm"), got, W, H);
+        FAIL() << "geen referentie " << path << ", vastleggen met UPDATE_GOLDEN=1 (render staat in "
+               << out_path(name + ".actual.ppm") << ")";
+    }
+    ASSERT_EQ(w, W);
+    ASSERT_EQ(h, H);
+
+    size_t bad = 0;
+    for (size_t i = 0; i < want.size(); i += 3) {
+        if (want[i] != got[i] || want[i + 1] != got[i + 1] || want[i + 2] != got[i + 2]) bad++;
+    }
+    if (bad) {
+        write_ppm(out_path(name + ".actual.ppm"), got, W, H);
+        write_ppm(out_path(name + ".diff.ppm"), diff_image(want, got), W, H);
+    }
+    EXPECT_EQ(bad, 0u) << name << ": " << bad << " pixels wijken af, zie "
+                       << out_path(name + ".diff.ppm");
+}
+
+// ---- gescripte toestanden ----
+
+struct Screen {
+    const char* name;
+    void (*show)();
+    void (*update)(const DisplayModel&);
+};
+
+static const Screen SCREENS[] = {
+    { "ui1", ui1_show, ui1_update },
+    { "ui2", ui2_show, ui2_update },
+    { "ui3", ui3_show, ui3_update },
+};
+
+// Model na n seconden demo-simulatie
+static DisplayModel model_after(int ticks) {
+    DisplayModel m = {};
+    demo_model_init(m);
+    for (int i = 0; i < ticks; i++) demo_model_tick_1s(m);
+    return m;
+}
+
+// Begin, halverwege, en voorbij de keerpunten (cursor aan het eind, UI2/3 op max)
+static const int STATES[] = { 0, 7, 40 };
+
+class UiGolden : public ::testing::TestWithParam<int> {};
+
+TEST_P(UiGolden, ScreensMatchReference) {
+    if (held_back()) GTEST_SKIP() << "geen referenties in golden/, vastleggen met UPDATE_GOLDEN=1";
+    const Screen& s = SCREENS[GetParam()];
+    for (int ticks : STATES) {
+        const DisplayModel m = model_after(ticks);
+        s.show();
+        s.update(m);
+        g_disp.refresh_full();
+        expect_matches_golden(std::string(s.name) + "_t" + std::to_string(ticks));
+    }
+}
+
+// Schermen blijven bestaan: na een rondje langs de andere UI's en terug moet
+// het beeld gelijk zijn aan de eerste keer (zelfde golden als hierboven)
+TEST_P(UiGolden, SwitchBackMatchesReference) {
+    if (held_back()) GTEST_SKIP() << "geen referenties in golden/, vastleggen met UPDATE_GOLDEN=1";
+    const Screen& s = SCREENS[GetParam()];
+    const DisplayModel m = model_after(0);
+    for (int i = 1; i <= 3; i++) {
+        const Screen& o = SCREENS[(GetParam() + i) % 3];
+        o.show();
+        o.update(m);
+        g_disp.refresh_full();
+    }
+    s.update(m);
+    g_disp.refresh_full();
+    expect_matches_golden(std::string(s.name) + "_t0");
+}
+
+// Per model-tick: aantal geflushte gebieden en pixels mag niet groeien
+TEST_P(UiGolden, UpdateAreasWithinBudget) {
+    if (held_back()) GTEST_SKIP() << "geen referenties in golden/, vastleggen met UPDATE_GOLDEN=1";
+    const Screen& s = SCREENS[GetParam()];
+    constexpr int TICKS = 10;
+
+    DisplayModel m = model_after(0);
+    s.show();
+    s.update(m);
+    g_disp.refresh_full();
+
+    std::ostringstream rec;
+    std::vector<std::pair<uint32_t, uint64_t>> got;
+    for (int t = 0; t < TICKS; t++) {
+        demo_model_tick_1s(m);
+        s.update(m);
+        g_disp.reset_stats();
+        g_disp.refresh();
+        got.emplace_back(static_cast<uint32_t>(g_disp.areas.size()), g_disp.pixels);
+        rec << t << " " << got.back().first << " " << got.back().second << "\n";
+    }
+
+    const std::string path = golden_path(std::string(s.name) + ".updates");
+    if (update_golden()) {
+        std::ofstream(path) << rec.str();
+        std::printf("update-budget vastgelegd: %s\n", path.c_str());
+        return;
+    }
+    std::ifstream in(path);
+    if (!in) {
+        std::ofstream(out_path(std::string(s.name) + ".updates")) << rec.str();
+        FAIL() << "geen referentie " << path << ", vastleggen met UPDATE_GOLDEN=1";
+    }
+
+    int t;
+    uint32_t areas;
+    uint64_t pixels;
+    while (in >> t >> areas >> pixels) {
+        ASSERT_LT(t, TICKS);
+        EXPECT_LE(got[t].first, areas) << s.name << " tick " << t << ": meer gebieden geflusht";
+        EXPECT_LE(got[t].second, pixels) << s.name << " tick " << t << ": meer pixels geflusht";
+        if (got[t].second < pixels) {
+            std::printf("%s tick %d: %llu px (budget %llu), golden bijwerken met UPDATE_GOLDEN=1\n",
+                        s.name, t, (unsigned long long)got[t].second, (unsigned long long)pixels);
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Screens, UiGolden, ::testing::Values(0, 1, 2),
+                         [](const ::testing::TestParamInfo<int>& i) { return std::string(SCREENS[i.param].name); });
+
+// Cursor-overlay (DRAW_POST van de chart): een cursorstap invalideert alleen de
+// oude en de nieuwe kolom, niet meer het hele lv_line-object en de serie eronder
+TEST(UiCursor, MoveInvalidatesOnlyOldAndNewColumn) {
+    int x, y, w, h;
+    ui1_chart_area(x, y, w, h);
+    const uint64_t budget = 2ull * 3 * h;   // 2 kolommen van lijnbreedte 2 + 1 px AA
+
+    DisplayModel m = model_after(0);
+    ui1_show();
+    ui1_update(m);
+    g_disp.refresh_full();
+
+    for (int step = 0; step < 10; step++) {
+        m.ui1.progress_index++;
+        g_disp.reset_stats();
+        ui1_update(m);
+        g_disp.refresh();
+        EXPECT_GT(g_disp.inv_px, 0u) << "stap " << step;
+        EXPECT_LE(g_disp.inv_px, budget) << "stap " << step;
+        EXPECT_LE(g_disp.pixels, budget) << "stap " << step;
+        EXPECT_EQ(g_disp.inv_areas, 2u) << "stap " << step;
+    }
+}
+
+// Ringmeter van UI2/UI3 los op een eigen scherm: een stap van 1% invalideert één
+// smalle strook (twee stappen van 3,6 graden: ruim onder 2% van het vlak) en de
+// gerenderde pixels hebben aan weerszijden van de waarde de juiste kleur.
+TEST(UiGauge, StepInvalidatesOnlyTheDelta) {
+    const lv_color_t ring = lv_color_hex(0x5A5400), indic = lv_color_hex(0xEDBE0E);
+    lv_obj_t* prev = lv_screen_active();
+    lv_obj_t* scr = lv_obj_create(nullptr);
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x000000), LV_PART_MAIN);
+    lv_obj_t* g = ui_gauge_create(scr, 180, 12, 270, 100, ring, indic);
+    lv_obj_center(g);
+    lv_screen_load(scr);
+    ui_gauge_set_value(g, 50);
+    g_disp.refresh_full();
+
+    for (int v = 51; v <= 60; v++) {
+        g_disp.reset_stats();
+        ui_gauge_set_value(g, v);
+        g_disp.refresh();
+        EXPECT_EQ(g_disp.inv_areas, 1u) << "v=" << v;
+        EXPECT_LE(g_disp.inv_px, 180u * 180u / 50) << "v=" << v;
+        EXPECT_LE(g_disp.pixels, 180u * 180u / 50) << "v=" << v;
+    }
+
+    // Midden van de ringdikte (straal 84) in stap 30 (indicator) en stap 80 (ring)
+    EXPECT_EQ(g_disp.pixel(320, 183), lv_color_to_u16(indic));
+    EXPECT_EQ(g_disp.pixel(159, 136), lv_color_to_u16(ring));
+
+    lv_screen_load(prev);
+    lv_obj_delete(scr);
+}
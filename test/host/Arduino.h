@@ -0,0 +1,26 @@
+// Arduino.h - minimale host-stub zodat target-headers op Linux compileren
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LOW    0x0
+#define HIGH   0x1
+#define INPUT  0x01
+#define OUTPUT 0x03
+
+inline void pinMode(int, int) {}
+inline void digitalWrite(int, int) {}
+
+// Nepklok: loopt alleen door via delay(), zodat tests deterministisch blijven
+inline uint32_t& host_millis() {
+  static uint32_t ms = 0;
+  return ms;
+}
+
+inline uint32_t millis() { return host_millis(); }
+inline uint32_t micros() { return host_millis() * 1000u; }
+inline void delay(uint32_t ms) { host_millis() += ms; }
+inline void delayMicroseconds(uint32_t) {}
@@ -0,0 +1,92 @@
+#include "host_display.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include "ili9488_emu.hpp"
+
+uint32_t host_tick_ms() {
+  using namespace std::chrono;
+  static const steady_clock::time_point t0 = steady_clock::now();
+  return static_cast<uint32_t>(duration_cast<milliseconds>(steady_clock::now() - t0).count());
+}
+
+static uint32_t elapsed_us(std::chrono::steady_clock::time_point t0) {
+  using namespace std::chrono;
+  return static_cast<uint32_t>(duration_cast<microseconds>(steady_clock::now() - t0).count());
+}
+
+static void host_flush_cb(lv_display_t* disp, const lv_area_t* area, uint8_t* px_map) {
+  HostDisplay* d = static_cast<HostDisplay*>(lv_display_get_user_data(disp));
+  const int32_t w = area->x2 - area->x1 + 1;
+  const int32_t h = area->y2 - area->y1 + 1;
+
+  for (int32_t y = 0; y < h; y++) {
+    std::memcpy(&d->fb[(area->y1 + y) * HostDisplay::WIDTH + area->x1],
+                px_map + 2 * w * y, 2 * w);
+  }
+
+  d->flushes++;
+  d->pixels += (uint64_t)w * h;
+  d->areas.push_back(*area);
+  lv_display_flush_ready(disp);
+}
+
+static void host_invalidate_cb(lv_event_t* e) {
+  HostDisplay* d = static_cast<HostDisplay*>(lv_event_get_user_data(e));
+  const lv_area_t* a = lv_event_get_invalidated_area(e);
+  d->inv_areas++;
+  d->inv_px += (uint64_t)lv_area_get_width(a) * lv_area_get_height(a);
+}
+
+void HostDisplay::create(uint16_t buf_lines) {
+  const size_t bytes = (size_t)WIDTH * buf_lines * 2;
+  buf1.assign(bytes, 0);
+  buf2.assign(bytes, 0);
+
+  disp = lv_display_create(WIDTH, HEIGHT);
+  lv_display_set_user_data(disp, this);
+  lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+  lv_display_set_flush_cb(disp, host_flush_cb);
+  lv_display_set_buffers(disp, buf1.data(), buf2.data(), bytes, LV_DISPLAY_RENDER_MODE_PARTIAL);
+#if LV_DRAW_SW_DRAW_UNIT_CNT > 1
+  lv_display_set_tile_cnt(disp, LV_DRAW_SW_DRAW_UNIT_CNT);
+#endif
+  lv_display_add_event_cb(disp, host_invalidate_cb, LV_EVENT_INVALIDATE_AREA, this);
+}
+
+void HostDisplay::reset_stats() {
+  flushes = 0;
+  pixels  = 0;
+  areas.clear();
+  inv_areas = 0;
+  inv_px    = 0;
+}
+
+uint32_t HostDisplay::refresh_full() {
+  lv_obj_invalidate(lv_screen_active());
+  return refresh();
+}
+
+uint32_t HostDisplay::refresh() {
+  const auto t0 = std::chrono::steady_clock::now();
+  lv_refr_now(disp);
+  return elapsed_us(t0);
+}
+
+bool HostDisplay::write_png(const std::string& path) const {
+  std::vector<uint8_t> rgb((size_t)WIDTH * HEIGHT * 3);
+  for (size_t i = 0; i < fb.size(); i++) {
+    const uint16_t c = fb[i];
+    rgb[3 * i + 0] = static_cast<uint8_t>(((c >> 11) & 0x1F) * 255 / 31);
+    rgb[3 * i + 1] = static_cast<uint8_t>(((c >> 5) & 0x3F) * 255 / 63);
+    rgb[3 * i + 2] = static_cast<uint8_t>((c & 0x1F) * 255 / 31);
+  }
+  const std::vector<uint8_t> png = emu::Ili9488Emu::encode_png(rgb, WIDTH, HEIGHT);
+
+  FILE* f = std::fopen(path.c_str(), "wb");
+  if (!f) return false;
+  std::fwrite(png.data(), 1, png.size(), f);
+  std::fclose(f);
+  return true;
+}
@@ -0,0 +1,40 @@
+// host_display.hpp - LVGL-display in geheugen voor de headless host-build
+#pragma once
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <lvgl.h>
+
+// Zelfde resolutie, kleurformaat en PARTIAL-buffers als lvgl_port_init() op het
+// target; de flush kopieert naar een RGB565-framebuffer i.p.v. naar het paneel.
+struct HostDisplay {
+  static constexpr int WIDTH  = 480;
+  static constexpr int HEIGHT = 320;
+
+  lv_display_t*         disp = nullptr;
+  std::vector<uint16_t> fb = std::vector<uint16_t>(WIDTH * HEIGHT, 0);
+  std::vector<uint8_t>  buf1, buf2;
+
+  // Per refresh: wat er geflusht is
+  uint32_t flushes = 0;
+  uint64_t pixels  = 0;
+  std::vector<lv_area_t> areas;
+  // Wat ui*_update invalideerde (LV_EVENT_INVALIDATE_AREA, vóór samenvoegen)
+  uint32_t inv_areas = 0;
+  uint64_t inv_px    = 0;
+
+  void create(uint16_t buf_lines = 10);
+  void reset_stats();
+
+  uint16_t pixel(int x, int y) const { return fb[y * WIDTH + x]; }
+
+  // Alles invalideren en meteen renderen + flushen; geeft de duur in us
+  uint32_t refresh_full();
+  // Alleen wat LVGL zelf dirty vindt; geeft de duur in us
+  uint32_t refresh();
+
+  bool write_png(const std::string& path) const;
+};
+
+// Monotone ms-klok voor lv_tick_set_cb
+uint32_t host_tick_ms();
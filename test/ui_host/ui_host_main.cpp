@@ -0,0 +1,215 @@
+// ui_host_main.cpp - UI1/2/3 headless renderen: PNG per scherm + render-kosten en
+// LVGL-heap (gedeelde vs. lokale stijlen), wissel-latency / poolfragmentatie
+// (opnieuw opbouwen vs. persistente schermen) en per-update werk van de
+// ringmeter (stock lv_arc vs. voorgerasterde ui_gauge)
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <lvgl.h>
+
+#include "host_display.hpp"
+#include "ui_screens.hpp"
+#include "ui_gauge.hpp"
+#include "ui_theme.hpp"
+#include "demo_model.hpp"
+
+struct Screen {
+  const char* name;
+  void (*show)();
+  void (*update)(const DisplayModel&);
+};
+
+static const Screen SCREENS[] = {
+  { "ui1", ui1_show, ui1_update },
+  { "ui2", ui2_show, ui2_update },
+  { "ui3", ui3_show, ui3_update },
+};
+
+// `n` wissels UI1 -> UI2 -> UI3 -> ..., elk tot en met het eerste volledige frame
+static void switch_bench(HostDisplay& d, DisplayModel& m, bool persistent, int n) {
+  ui_screens_set_persistent(persistent);
+  const auto t_build = std::chrono::steady_clock::now();
+  if (persistent) ui_screens_create();
+  const auto build_us = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - t_build).count();
+
+  uint64_t sum = 0, worst = 0;
+  uint32_t frag_max = 0;
+  for (int i = 0; i < n; i++) {
+    const Screen& s = SCREENS[i % 3];
+    const auto t0 = std::chrono::steady_clock::now();
+    s.show();
+    s.update(m);
+    d.refresh_full();
+    const uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - t0).count();
+    sum += us;
+    if (us > worst) worst = us;
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    if (mon.frag_pct > frag_max) frag_max = mon.frag_pct;
+  }
+
+  lv_mem_monitor_t mon;
+  lv_mem_monitor(&mon);
+  std::printf("%-10s %8lu %10.1f %10lu %7u%% %7u%% %9u%% %10lu\n",
+              persistent ? "persistent" : "rebuild", (unsigned long)build_us,
+              double(sum) / n, (unsigned long)worst, (unsigned)mon.used_pct,
+              (unsigned)mon.frag_pct, (unsigned)frag_max, (unsigned long)mon.free_biggest_size);
+}
+
+// Ringmeter zoals op UI2/UI3 (180x180, 12 px, 0..100%) op een eigen scherm; `n`
+// updates met stappen van `delta` procent, per update gerenderd en geflusht
+static void gauge_bench(HostDisplay& d, bool stock, int delta, int n) {
+  lv_obj_t* prev = lv_screen_active();
+  lv_obj_t* scr = lv_obj_create(nullptr);
+  lv_obj_set_style_bg_color(scr, lv_color_hex(0x000000), LV_PART_MAIN);
+
+  const lv_color_t ring = lv_color_hex(0x5A5400), indic = lv_color_hex(0xEDBE0E);
+  lv_obj_t* g = nullptr;
+  if (stock) {
+    g = lv_arc_create(scr);
+    lv_obj_set_size(g, 180, 180);
+    lv_arc_set_range(g, 0, 100);
+    lv_arc_set_bg_angles(g, 0, 360);
+    lv_arc_set_rotation(g, 270);
+    lv_obj_set_style_arc_width(g, 12, LV_PART_MAIN);
+    lv_obj_set_style_arc_color(g, ring, LV_PART_MAIN);
+    lv_obj_set_style_arc_width(g, 12, LV_PART_INDICATOR);
+    lv_obj_set_style_arc_color(g, indic, LV_PART_INDICATOR);
+    lv_obj_set_style_opa(g, LV_OPA_TRANSP, LV_PART_KNOB);
+    lv_obj_clear_flag(g, LV_OBJ_FLAG_CLICKABLE);
+    lv_arc_set_value(g, 0);
+  } else {
+    g = ui_gauge_create(scr, 180, 12, 270, 100, ring, indic);
+  }
+  lv_obj_center(g);
+  lv_screen_load(scr);
+  d.refresh_full();
+
+  uint64_t us = 0, px = 0, inv = 0;
+  int v = 0, dir = 1;
+  for (int i = 0; i < n; i++) {
+    // Heen en weer tussen 0 en 100 (kaatsen aan de randen)
+    v += dir * delta;
+    if (v > 100) { v = 200 - v; dir = -1; }
+    if (v < 0)   { v = -v;      dir = 1; }
+    d.reset_stats();
+    if (stock) lv_arc_set_value(g, v);
+    else ui_gauge_set_value(g, v);
+    us  += d.refresh();
+    px  += d.pixels;
+    inv += d.inv_px;
+  }
+
+  std::printf("%-8s %6d%% %10.1f %10lu %10lu\n", stock ? "lv_arc" : "ui_gauge", delta,
+              double(us) / n, (unsigned long)(inv / n), (unsigned long)(px / n));
+
+  lv_screen_load(prev);
+  lv_obj_delete(scr);
+}
+
+// Per scherm: LVGL-heap voor het opbouwen, opbouw + eerste frame, volledige
+// repaint en model-tick. shared = gedeelde ui_theme-stijlen, anders lokale
+// stijlen per object (het oude gedrag) ter vergelijking.
+static void screen_bench(HostDisplay& d, DisplayModel& m, bool shared, int reps,
+                         const std::string* png_dir) {
+  ui_screens_reset();
+  ui_theme_set_shared(shared);
+
+  for (const Screen& s : SCREENS) {
+    // Opbouwen + eerste frame
+    lv_mem_monitor_t mon0, mon1;
+    lv_mem_monitor(&mon0);
+    const auto t_create = std::chrono::steady_clock::now();
+    s.show();
+    s.update(m);
+    d.refresh_full();
+    const auto create_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - t_create).count();
+    lv_mem_monitor(&mon1);
+    const long heap = long(mon0.free_size) - long(mon1.free_size);
+
+    // Volledige repaint
+    uint64_t full = 0;
+    for (int r = 0; r < reps; r++) full += d.refresh_full();
+
+    // Model-tick zoals op het device: alleen wat ui*_update invalideert
+    uint64_t upd = 0, upd_px = 0, upd_areas = 0, inv_px = 0;
+    for (int r = 0; r < reps; r++) {
+      demo_model_tick_1s(m);
+      d.reset_stats();
+      s.update(m);
+      upd += d.refresh();
+      upd_px += d.pixels;
+      upd_areas += d.areas.size();
+      inv_px += d.inv_px;
+    }
+
+    std::printf("%-4s %-7s %8ld %10lu %12.1f %12.1f %10lu %8.1f %10lu\n", s.name,
+                shared ? "gedeeld" : "lokaal", heap,
+                (unsigned long)create_us, double(full) / reps, double(upd) / reps,
+                (unsigned long)(upd_px / reps), double(upd_areas) / reps,
+                (unsigned long)(inv_px / reps));
+
+    // Beeld na de laatste update
+    if (png_dir) {
+      d.refresh_full();
+      d.write_png(*png_dir + "/" + s.name + ".png");
+    }
+  }
+}
+
+// UI1 volledige repaint per aantal tegels. Met -DUI_HOST_DUAL_CORE=ON zijn er twee
+// draw units (pthreads); tiles=1 is dan de vergelijking met één rendercore.
+static void render_bench(HostDisplay& d, DisplayModel& m, int reps) {
+  SCREENS[0].show();
+  SCREENS[0].update(m);
+  d.refresh_full();
+
+  for (uint32_t tiles = 1; tiles <= LV_DRAW_SW_DRAW_UNIT_CNT; tiles++) {
+    lv_display_set_tile_cnt(d.disp, tiles);
+    d.refresh_full();
+    uint64_t us = 0;
+    for (int r = 0; r < reps; r++) us += d.refresh_full();
+    std::printf("%-6s %6d %6lu %12.1f\n", SCREENS[0].name, LV_DRAW_SW_DRAW_UNIT_CNT,
+                (unsigned long)tiles, double(us) / reps);
+  }
+  lv_display_set_tile_cnt(d.disp, LV_DRAW_SW_DRAW_UNIT_CNT);
+}
+
+int main(int argc, char** argv) {
+  const std::string out_dir = (argc > 1) ? argv[1] : ".";
+  const int reps = (argc > 2) ? std::atoi(argv[2]) : 50;
+
+  lv_init();
+  lv_tick_set_cb(host_tick_ms);
+
+  HostDisplay d;
+  d.create();
+
+  DisplayModel m = {};
+  demo_model_init(m);
+
+  std::printf("%-4s %-7s %8s %10s %12s %12s %10s %8s %10s\n", "ui", "stijlen", "heap B",
+              "create us", "full us", "update us", "upd px", "areas", "inv px");
+  screen_bench(d, m, false, reps, nullptr);
+  screen_bench(d, m, true, reps, &out_dir);
+
+  std::printf("\n%-10s %8s %10s %10s %8s %8s %10s %10s\n", "switch", "build us",
+              "avg us", "max us", "used", "frag", "frag max", "biggest");
+  switch_bench(d, m, false, reps);
+  switch_bench(d, m, true, reps);
+
+  std::printf("\n%-8s %7s %10s %10s %10s\n", "gauge", "stap", "update us", "inv px", "upd px");
+  for (int delta : { 1, 5, 37 }) {
+    gauge_bench(d, true, delta, reps * 4);
+    gauge_bench(d, false, delta, reps * 4);
+  }
+
+  std::printf("\n%-6s %6s %6s %12s\n", "render", "units", "tiles", "full us");
+  render_bench(d, m, reps);
+  return 0;
+}